@@ -29,29 +29,35 @@
 
 #include "Scaylay.hpp"
 
-#include <algorithm> // for std::sort
+#include <algorithm> // for std::sort, std::lower_bound, std::upper_bound, std::binary_search and std::remove_if
+#include <utility> // for std::swap and std::move
 
 #include <string>
 #include <sstream>
+#include <cstring> // for std::memcpy
+#include <cmath> // for std::floor
+#include <limits> // for std::numeric_limits
 
 namespace scaylay
 {
 
 std::stringstream ss;
 
-inline std::string stringFrom(const Vector2& v, const std::string& separator = ", ", const std::size_t precision = 0u)
+template <class T>
+inline std::string stringFrom(const Vector2Base<T>& v, const std::string& separator = ", ", const std::size_t precision = 0u)
 {
 	ss.str(std::string());
 
 	ss.precision(precision);
 
-	ss << std::fixed << "(" << v.x << separator << v.y << ")";
+	ss << std::fixed << "(" << static_cast<double>(v.x) << separator << static_cast<double>(v.y) << ")";
 
 	return ss.str();
 }
-inline std::string stringFrom(const Property2& v, const std::string& separator = ", ", const std::size_t precision = 0u)
+template <class T>
+inline std::string stringFrom(const Property2Base<T>& v, const std::string& separator = ", ", const std::size_t precision = 0u)
 {
-	return stringFrom(Vector2{ v.x.value, v.y.value }, separator, precision);
+	return stringFrom(Vector2Base<T>{ v.x.value, v.y.value }, separator, precision);
 }
 inline std::string stringFrom(const Vector2Anchor& v, const std::string& separator = ", ")
 {
@@ -61,17 +67,45 @@ inline std::string stringFrom(const Vector2Relation& v, const std::string& separ
 {
 	return "(" + std::to_string(static_cast<unsigned int>(v.x)) + separator + std::to_string(static_cast<unsigned int>(v.y)) + ")";
 }
-std::string Design::getInfo()
+template <class ValueT>
+inline void writeExportValue(unsigned char* const target, const std::size_t offset, const ValueT value)
+{
+	if (offset != ExportLayout::unused)
+		std::memcpy(target + offset, &value, sizeof(value));
+}
+template <class ValueT>
+inline void writeExportVector(unsigned char* const target, const std::size_t offset, const ValueT x, const ValueT y)
+{
+	if (offset == ExportLayout::unused)
+		return;
+	writeExportValue(target, offset, x);
+	writeExportValue(target, offset + sizeof(x), y);
+}
+inline bool isExportValueInStride(const std::size_t offset, const std::size_t size, const std::size_t stride)
+{
+	return (offset == ExportLayout::unused) || ((offset <= stride) && (size <= (stride - offset)));
+}
+inline std::int16_t clampToInt16(const double value) // NaN becomes zero
+{
+	if (value != value)
+		return 0;
+	return static_cast<std::int16_t>(std::min(std::max(value, static_cast<double>(std::numeric_limits<std::int16_t>::min())), static_cast<double>(std::numeric_limits<std::int16_t>::max())));
+}
+template <class T>
+std::string DesignBase<T>::getInfo()
 {
 	if (m_frames.size() == 0u)
 		return "";
 
-	std::size_t i{ 0u }; 
 	std::string s;
-	for (auto& f : m_frames)
+	const std::size_t framesSize{ m_frames.size() };
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
 	{
-		Vector2 difference{ f.end.x.value - f.start.x.value, f.end.y.value - f.start.y.value };
-		s += "[" + std::to_string(i++) + "] ";
+		const Frame& f{ m_frames[i] };
+		const Property2 start{ priv_getProperty(i, ValueType::Start, ComponentType::X), priv_getProperty(i, ValueType::Start, ComponentType::Y) };
+		const Property2 end{ priv_getProperty(i, ValueType::End, ComponentType::X), priv_getProperty(i, ValueType::End, ComponentType::Y) };
+		Vector2 difference{ end.x.value - start.x.value, end.y.value - start.y.value };
+		s += "[" + std::to_string(i) + "] ";
 		s += "prnt:";
 		s += std::to_string(f.parentIndex);
 		s += " || grp: ";
@@ -79,27 +113,27 @@ std::string Design::getInfo()
 		s += " || dth: ";
 		s += std::to_string(f.depth);
 		s += " || st: ";
-		s += stringFrom(f.start, ", ", 2u);
+		s += stringFrom(start, ", ", 2u);
 		s += " {rel: ";
-		s += stringFrom({ f.start.x.relation, f.start.y.relation }, ", ");
+		s += stringFrom({ start.x.relation, start.y.relation }, ", ");
 		s += "}";
 		s += " {anc: ";
-		s += stringFrom({ f.start.x.anchor, f.start.y.anchor }, ", ");
+		s += stringFrom({ start.x.anchor, start.y.anchor }, ", ");
 		s += "}";
 		s += " || nd: ";
-		s += stringFrom(f.end, ", ", 2u);
+		s += stringFrom(end, ", ", 2u);
 		s += " {rel: ";
-		s += stringFrom({ f.end.x.relation, f.end.y.relation }, ", ");
+		s += stringFrom({ end.x.relation, end.y.relation }, ", ");
 		s += "}";
 		s += " {anc: ";
-		s += stringFrom({ f.end.x.anchor, f.end.y.anchor }, ", ");
+		s += stringFrom({ end.x.anchor, end.y.anchor }, ", ");
 		s += "}";
 		s += " || df: ";
 		s += stringFrom(difference, "x", 2u);
 		for (std::size_t g{ 0u }; g < getNumberOfGenerics(); ++g)
 		{
 			s += " || gen[" + std::to_string(g) + "]: ";
-			s += std::to_string(f.generics[g].value);
+			s += std::to_string(static_cast<double>(m_genericValues[(i * m_numOfGenerics) + g]));
 		}
 		s += "\n";
 	}
@@ -108,14 +142,47 @@ std::string Design::getInfo()
 
 
 
-Design::Design()
-	: m_frames()
-	, m_numOfGenerics{ 0u }
+template <class T>
+DesignBase<T>::DesignBase()
+	: DesignBase(std::pmr::get_default_resource())
 {
 
 }
 
-std::size_t Design::add(
+template <class T>
+DesignBase<T>::DesignBase(std::pmr::memory_resource* const memoryResource)
+	: m_frames(memoryResource)
+	, m_offsets(memoryResource)
+	, m_genericValues(memoryResource)
+	, m_genericLayouts(memoryResource)
+	, m_numOfGenerics{ 0u }
+	, m_layout(memoryResource)
+	, m_previousLayout(memoryResource)
+	, m_frameStates(memoryResource)
+	, m_resolveOrder(memoryResource)
+	, m_resolveLevels(memoryResource)
+	, m_resolveChain(memoryResource)
+	, m_changedFrames(memoryResource)
+	, m_changeCallback()
+	, m_isLayoutUpdated{ false }
+	, m_isResolveOrderDirty{ true }
+	, m_variants(memoryResource)
+	, m_activeVariant{ 0u }
+	, m_structureVersion{ 0u }
+	, m_drawOrder(memoryResource)
+	, m_resolveRequests()
+	, m_animationTracks(memoryResource)
+	, m_animationValues(memoryResource)
+	, m_childrenIndex(memoryResource)
+	, m_isChildrenIndexDirty{ true }
+	, m_viewportValues(memoryResource)
+	, m_snapshotChunks(memoryResource)
+{
+	m_variants.emplace_back(memoryResource);
+}
+
+template <class T>
+std::size_t DesignBase<T>::add(
 	const Property2 startOffset,
 	const bool isConsideredPoint,
 	const int parentIndex,
@@ -124,25 +191,94 @@ std::size_t Design::add(
 	const Property2 endOffset,
 	const std::vector<Property> generics)
 {
-
-	m_frames.emplace_back(Frame{
-		isConsideredPoint,
-		parentIndex,
-		groupId,
-		depth,
-		startOffset,
-		endOffset,
-		generics });
-
 	if (generics.size() > m_numOfGenerics)
-		m_numOfGenerics = generics.size();
+		resizeGenerics(generics.size());
+
+	std::uint32_t layout{ isConsideredPoint ? layoutPointFlag : 0u };
+	layout |= priv_packLayout(startOffset.x.relation, startOffset.x.anchor) << priv_getLayoutShift(ValueType::Start, ComponentType::X);
+	layout |= priv_packLayout(startOffset.y.relation, startOffset.y.anchor) << priv_getLayoutShift(ValueType::Start, ComponentType::Y);
+	layout |= priv_packLayout(endOffset.x.relation, endOffset.x.anchor) << priv_getLayoutShift(ValueType::End, ComponentType::X);
+	layout |= priv_packLayout(endOffset.y.relation, endOffset.y.anchor) << priv_getLayoutShift(ValueType::End, ComponentType::Y);
+
+	m_frames.push_back({ parentIndex, groupId, depth });
+	priv_insertIntoDrawOrder(m_frames.size() - 1u);
+	priv_invalidateSnapshotChunk(m_frames.size() - 1u);
+	m_frameStates.push_back(frameStateDirty);
+	m_isLayoutUpdated = false;
+	m_isResolveOrderDirty = true;
+	m_isChildrenIndexDirty = true;
+	++m_structureVersion;
+
+	// the frame is added to all variants
+	priv_forEachVariantData([&](std::pmr::vector<Offsets>& offsets, std::pmr::vector<T>& genericValues, std::pmr::vector<std::uint8_t>& genericLayouts)
+	{
+		offsets.push_back({ startOffset.getValue2(), endOffset.getValue2(), layout });
 
-	resizeGenerics(m_numOfGenerics);
+		// default generic of { 0, relative } added if not enough generics in frame
+		for (std::size_t g{ 0u }; g < m_numOfGenerics; ++g)
+		{
+			const Property generic{ (g < generics.size()) ? generics[g] : Property{ T{}, RelationType::Relative, AnchorPoint::Start } };
+			genericValues.push_back(generic.value);
+			genericLayouts.push_back(static_cast<std::uint8_t>(priv_packLayout(generic.relation, generic.anchor)));
+		}
+	});
 
 	return m_frames.size() - 1u;
 }
 
-std::size_t Design::addAbsoluteRectangle(const Vector2 position, const Vector2 size)
+template <class T>
+void DesignBase<T>::resizeGenerics(const std::size_t numberOfGenerics)
+{
+	const std::size_t framesSize{ m_frames.size() };
+	const std::size_t numberToKeep{ (numberOfGenerics < m_numOfGenerics) ? numberOfGenerics : m_numOfGenerics };
+
+	priv_forEachVariantData([&](std::pmr::vector<Offsets>&, std::pmr::vector<T>& genericValues, std::pmr::vector<std::uint8_t>& genericLayouts)
+	{
+		// default generic of { 0, relative } added if not enough generics in frame
+		std::pmr::vector<T> values(framesSize * numberOfGenerics, T{}, genericValues.get_allocator());
+		std::pmr::vector<std::uint8_t> layouts(framesSize * numberOfGenerics, static_cast<std::uint8_t>(priv_packLayout(RelationType::Relative, AnchorPoint::Start)), genericLayouts.get_allocator());
+		for (std::size_t i{ 0u }; i < framesSize; ++i)
+		{
+			for (std::size_t g{ 0u }; g < numberToKeep; ++g)
+			{
+				values[(i * numberOfGenerics) + g] = genericValues[(i * m_numOfGenerics) + g];
+				layouts[(i * numberOfGenerics) + g] = genericLayouts[(i * m_numOfGenerics) + g];
+			}
+		}
+
+		std::swap(genericValues, values);
+		std::swap(genericLayouts, layouts);
+	});
+
+	m_numOfGenerics = numberOfGenerics;
+	++m_structureVersion;
+	priv_invalidateAll();
+}
+
+template <class T>
+void DesignBase<T>::removeGeneric(const std::size_t genericIndex)
+{
+	if (genericIndex >= m_numOfGenerics)
+		return;
+
+	// shuffle the following generics down into its place and then trim the (now unused) last one
+	const std::size_t framesSize{ m_frames.size() };
+	priv_forEachVariantData([&](std::pmr::vector<Offsets>&, std::pmr::vector<T>& genericValues, std::pmr::vector<std::uint8_t>& genericLayouts)
+	{
+		for (std::size_t i{ 0u }; i < framesSize; ++i)
+		{
+			for (std::size_t g{ genericIndex + 1u }; g < m_numOfGenerics; ++g)
+			{
+				genericValues[(i * m_numOfGenerics) + g - 1u] = genericValues[(i * m_numOfGenerics) + g];
+				genericLayouts[(i * m_numOfGenerics) + g - 1u] = genericLayouts[(i * m_numOfGenerics) + g];
+			}
+		}
+	});
+	resizeGenerics(m_numOfGenerics - 1u);
+}
+
+template <class T>
+std::size_t DesignBase<T>::addAbsoluteRectangle(const Vector2 position, const Vector2 size)
 {
 	return add(Property2{ position, { RelationType::Absolute, RelationType::Absolute }, { AnchorPoint::Start, AnchorPoint::Start } },
 		false,
@@ -152,7 +288,8 @@ std::size_t Design::addAbsoluteRectangle(const Vector2 position, const Vector2 s
 		Property2{ { position.x + size.x, position.y + size.y }, { RelationType::Absolute, RelationType::Absolute }, { AnchorPoint::Start, AnchorPoint::Start } });
 }
 
-std::size_t Design::addRelativeRectangle(const std::size_t parentIndex, const Vector2 position, const Vector2 size)
+template <class T>
+std::size_t DesignBase<T>::addRelativeRectangle(const std::size_t parentIndex, const Vector2 position, const Vector2 size)
 {
 	return add(Property2{ position, { RelationType::Relative, RelationType::Relative }, { AnchorPoint::Start, AnchorPoint::Start } },
 		false,
@@ -162,144 +299,914 @@ std::size_t Design::addRelativeRectangle(const std::size_t parentIndex, const Ve
 		Property2{ { position.x + size.x, position.y + size.y }, { RelationType::Relative, RelationType::Relative }, { AnchorPoint::Start, AnchorPoint::Start } });
 }
 
-std::vector<std::size_t> Design::getFramesInGroup(const int groupId) const
+template <class T>
+std::vector<std::size_t> DesignBase<T>::getFramesInGroup(const int groupId) const
 {
 	std::vector<std::size_t> frames;
+	getFramesInGroup(groupId, frames);
+	return frames;
+}
 
-	const std::size_t framesSize{ m_frames.size() };
-	for (std::size_t i{ 0u }; i < framesSize; ++i)
-	{
-		if (m_frames[i].groupId == groupId)
-			frames.push_back(i);
-	}
+template <class T>
+std::vector<std::size_t> DesignBase<T>::getFramesInGroupRange(const int groupIdMin, const int groupIdMax, const bool useInsideRange) const
+{
+	std::vector<std::size_t> frames;
+	getFramesInGroupRange(groupIdMin, groupIdMax, useInsideRange, frames);
+	return frames;
+}
+
+template <class T>
+std::vector<std::size_t> DesignBase<T>::getFramesInGroups(const std::vector<int>& groupIds) const
+{
+	std::vector<std::size_t> frames;
+	getFramesInGroups(groupIds, frames);
+	return frames;
+}
 
+template <class T>
+std::vector<std::size_t> DesignBase<T>::getFramesAtDepth(const int depth) const
+{
+	std::vector<std::size_t> frames;
+	getFramesAtDepth(depth, frames);
 	return frames;
 }
 
-std::vector<std::size_t> Design::getFramesInGroupRange(const int groupIdMin, const int groupIdMax, const bool useInsideRange) const
+template <class T>
+std::vector<std::size_t> DesignBase<T>::getFramesInDepthRange(const int depthMin, const int depthMax, const bool useInsideRange, const bool sortAscending) const
 {
 	std::vector<std::size_t> frames;
+	getFramesInDepthRange(depthMin, depthMax, useInsideRange, sortAscending, frames);
+	return frames;
+}
 
-	const std::size_t framesSize{ m_frames.size() };
-	for (std::size_t i{ 0u }; i < framesSize; ++i)
+template <class T>
+std::vector<std::size_t> DesignBase<T>::getFramesToDepth(const int depth, const bool useBelow, const bool sortAscending) const
+{
+	std::vector<std::size_t> frames;
+	getFramesToDepth(depth, useBelow, sortAscending, frames);
+	return frames;
+}
+
+template <class T>
+std::vector<std::size_t> DesignBase<T>::getFramesAtAllDepths(const bool sortAscending) const
+{
+	std::vector<std::size_t> frames;
+	getFramesAtAllDepths(sortAscending, frames);
+	return frames;
+}
+
+template <class T>
+std::vector<Vector2Base<T>> DesignBase<T>::getPointsInFrame(const std::size_t index, const std::vector<Vector2>& points, const std::vector<Vector2Relation>& relations, const std::vector<Vector2Anchor>& anchors) const
+{
+	if (!priv_isValidFrameIndex(index) || (relations.size() < points.size()) || (anchors.size() < points.size()))
+		return{};
+
+	const Range rangeX{ priv_getRange(index, ComponentType::X) };
+	const Range rangeY{ priv_getRange(index, ComponentType::Y) };
+
+	const std::size_t numberOfPoints{ points.size() };
+	std::vector<Vector2> results(numberOfPoints);
+	for (std::size_t i{ 0u }; i < numberOfPoints; ++i)
 	{
-		if (useInsideRange == (m_frames[i].groupId >= groupIdMin) && (m_frames[i].groupId <= groupIdMax))
-			frames.push_back(i);
+		const Transform x{ priv_getPointTransform(relations[i].x, anchors[i].x, rangeX) };
+		const Transform y{ priv_getPointTransform(relations[i].y, anchors[i].y, rangeY) };
+		results[i] = { (points[i].x * x.scale) + x.offset, (points[i].y * y.scale) + y.offset };
 	}
 
-	return frames;
+	return results;
+}
+
+template <class T>
+void DesignBase<T>::getPointsInFrame(const std::size_t index, const Vector2* const points, Vector2* const results, const std::size_t numberOfPoints, const Vector2Relation relations, const Vector2Anchor anchors) const
+{
+	if (!priv_isValidFrameIndex(index))
+		return;
+
+	// the frame is resolved only once. every point then uses the same transform so this loop is branch-free and can be vectorised by the compiler
+	const Transform x{ priv_getPointTransform(relations.x, anchors.x, priv_getRange(index, ComponentType::X)) };
+	const Transform y{ priv_getPointTransform(relations.y, anchors.y, priv_getRange(index, ComponentType::Y)) };
+	const T scaleX{ x.scale };
+	const T offsetX{ x.offset };
+	const T scaleY{ y.scale };
+	const T offsetY{ y.offset };
+
+	for (std::size_t i{ 0u }; i < numberOfPoints; ++i)
+	{
+		const Vector2 point{ points[i] };
+		results[i] = { (point.x * scaleX) + offsetX, (point.y * scaleY) + offsetY };
+	}
+}
+
+template <class T>
+void DesignBase<T>::getLocalPointsInFrame(const std::size_t index, const Vector2* const absolutePoints, Vector2* const results, const std::size_t numberOfPoints, const Vector2Relation relations, const Vector2Anchor anchors) const
+{
+	if (!priv_isValidFrameIndex(index))
+		return;
+
+	const Transform x{ priv_getInverseTransform(priv_getPointTransform(relations.x, anchors.x, priv_getRange(index, ComponentType::X))) };
+	const Transform y{ priv_getInverseTransform(priv_getPointTransform(relations.y, anchors.y, priv_getRange(index, ComponentType::Y))) };
+	const T scaleX{ x.scale };
+	const T offsetX{ x.offset };
+	const T scaleY{ y.scale };
+	const T offsetY{ y.offset };
+
+	for (std::size_t i{ 0u }; i < numberOfPoints; ++i)
+	{
+		const Vector2 point{ absolutePoints[i] };
+		results[i] = { (point.x * scaleX) + offsetX, (point.y * scaleY) + offsetY };
+	}
+}
+
+template <class T>
+typename DesignBase<T>::Rectangle DesignBase<T>::getClipRectangle(const std::size_t index) const
+{
+	if (!priv_isValidFrameIndex(index))
+		return{};
+
+	if (m_isLayoutUpdated)
+		return{ m_layout.clipStarts[index], m_layout.clipEnds[index] };
+
+	// intersect with each clipping ancestor in turn (as was resolved during update)
+	Vector2 start{ getStartAbsolute(index) };
+	Vector2 end{ getEndAbsolute(index) };
+	for (const std::size_t ancestor : getAncestors(index))
+	{
+		if (!priv_isClippingChildren(ancestor))
+			continue;
+
+		const Vector2 ancestorStart{ getStartAbsolute(ancestor) };
+		const Vector2 ancestorEnd{ getEndAbsolute(ancestor) };
+		start = { std::max(start.x, ancestorStart.x), std::max(start.y, ancestorStart.y) };
+		end = { std::min(end.x, ancestorEnd.x), std::min(end.y, ancestorEnd.y) };
+	}
+	return{ start, end };
+}
+
+template <class T>
+int DesignBase<T>::getClippingFrame(const std::size_t index) const
+{
+	if (!priv_isValidFrameIndex(index))
+		return -1;
+
+	const int parentIndex{ m_frames[index].parentIndex };
+	if (m_isLayoutUpdated)
+		return priv_isValidFrameIndex(parentIndex) ? m_layout.clipFrames[parentIndex] : -1;
+
+	for (const std::size_t ancestor : getAncestors(index))
+	{
+		if (priv_isClippingChildren(ancestor))
+			return static_cast<int>(ancestor);
+	}
+	return -1;
 }
 
-std::vector<std::size_t> Design::getFramesInGroups(const std::vector<int>& groupIds) const
+template <class T>
+std::vector<std::size_t> DesignBase<T>::getFullyClippedFrames() const
 {
 	std::vector<std::size_t> frames;
+	getFullyClippedFrames(frames);
+	return frames;
+}
+
+template <class T>
+IndexRange DesignBase<T>::getDrawOrderInDepthRange(const int depthMin, const int depthMax) const
+{
+	const std::size_t* const first{ m_drawOrder.data() };
+	const std::size_t* const last{ first + m_drawOrder.size() };
+	if (depthMin > depthMax)
+		return{ last, last };
+
+	return{
+		std::lower_bound(first, last, depthMin, [&](const std::size_t index, const int depth) { return m_frames[index].depth < depth; }),
+		std::upper_bound(first, last, depthMax, [&](const int depth, const std::size_t index) { return depth < m_frames[index].depth; }) };
+}
+
+template <class T>
+IndexRange DesignBase<T>::getChildren(const std::size_t index) const
+{
+	if (!priv_isValidFrameIndex(index))
+		return{ nullptr, nullptr };
+
+	if (m_isChildrenIndexDirty)
+		priv_updateChildrenIndex();
+
+	const std::size_t* const children{ m_childrenIndex.children.data() };
+	return{ children + m_childrenIndex.childrenStarts[index], children + m_childrenIndex.childrenStarts[index + 1u] };
+}
+
+template <class T>
+IndexRange DesignBase<T>::getDescendants(const std::size_t index) const
+{
+	if (!priv_isValidFrameIndex(index))
+		return{ nullptr, nullptr };
+
+	if (m_isChildrenIndexDirty)
+		priv_updateChildrenIndex();
 
+	// the frame is first in its own subtree
+	const std::size_t* const first{ m_childrenIndex.depthFirst.data() + m_childrenIndex.depthFirstPositions[index] };
+	return{ first + 1u, first + m_childrenIndex.subtreeSizes[index] };
+}
+
+template <class T>
+const std::pmr::vector<std::size_t>& DesignBase<T>::update(const T epsilon)
+{
 	const std::size_t framesSize{ m_frames.size() };
-	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	const std::size_t genericsSize{ framesSize * m_numOfGenerics };
+
+	if (m_isResolveOrderDirty)
+		priv_updateResolveOrder();
+	if (m_isChildrenIndexDirty)
+		priv_updateChildrenIndex(); // so that (const) hierarchy queries do not need to rebuild it until the structure next changes
+
+	// new frames have no previous values so they are left as zero (and are always reported as changed)
+	// if the number of generics has changed, all of the cached generics are invalid so every frame is reported as changed
+	const std::size_t previousFramesSize{ m_layout.starts.size() };
+	const bool isNumberOfGenericsChanged{ m_layout.numOfGenerics != m_numOfGenerics };
+	if (isNumberOfGenericsChanged)
+	{
+		m_layout.generics.assign(genericsSize, T{});
+		m_previousLayout.generics.assign(genericsSize, T{});
+		m_layout.numOfGenerics = m_numOfGenerics;
+	}
+	m_layout.generics.resize(genericsSize);
+	m_layout.starts.resize(framesSize);
+	m_layout.ends.resize(framesSize);
+	m_layout.rangeStarts.resize(framesSize);
+	m_layout.rangeEnds.resize(framesSize);
+	m_layout.clipStarts.resize(framesSize);
+	m_layout.clipEnds.resize(framesSize);
+	m_layout.clipFrames.resize(framesSize, -1);
+	m_previousLayout.starts.resize(framesSize);
+	m_previousLayout.ends.resize(framesSize);
+	m_previousLayout.generics.resize(genericsSize);
+	m_previousLayout.clipStarts.resize(framesSize);
+	m_previousLayout.clipEnds.resize(framesSize);
+
+	m_changedFrames.clear();
+	for (auto& frameState : m_frameStates)
+		frameState &= ~(frameStateChanged | frameStateRangeChanged | frameStateClipChanged);
+
+	// parents are always resolved before their children so a frame only needs resolving again if it was changed itself or its parent's range (or generics) changed
+	for (auto& index : m_resolveOrder)
 	{
-		for (auto& groupId : groupIds)
+		const int parentIndex{ m_frames[index].parentIndex };
+		const bool isParentChanged{ priv_isValidFrameIndex(parentIndex) && ((m_frameStates[parentIndex] & frameStateRangeChanged) != 0u) };
+		const bool isResolveNeeded{ ((m_frameStates[index] & frameStateDirty) != 0u) || isParentChanged };
+		const bool isCompareOnly{ (m_frameStates[index] & frameStateCompare) != 0u }; // previous values were stored when switching variants
+		if (!isResolveNeeded && !isCompareOnly)
+			continue;
+
+		const Vector2 rangeStart{ m_layout.rangeStarts[index] };
+		const Vector2 rangeEnd{ m_layout.rangeEnds[index] };
+		if (!isCompareOnly)
+		{
+			m_previousLayout.starts[index] = m_layout.starts[index];
+			m_previousLayout.ends[index] = m_layout.ends[index];
+			m_previousLayout.clipStarts[index] = m_layout.clipStarts[index];
+			m_previousLayout.clipEnds[index] = m_layout.clipEnds[index];
+			for (std::size_t g{ 0u }; g < m_numOfGenerics; ++g)
+				m_previousLayout.generics[(index * m_numOfGenerics) + g] = m_layout.generics[(index * m_numOfGenerics) + g];
+		}
+
+		// clip rectangles are resolved in the same pass since every ancestor's clip rectangle is already resolved
+		bool isClipChanged{ false };
+		if (isResolveNeeded)
+		{
+			priv_resolveFrame(index, m_layout);
+			isClipChanged = priv_resolveClip(index);
+		}
+
+		// (when comparing only, the previous generics are not the ones that the children were resolved with so they are always resolved again)
+		bool isRangeChanged{ isClipChanged || (isResolveNeeded && isCompareOnly) || (rangeStart.x != m_layout.rangeStarts[index].x) || (rangeStart.y != m_layout.rangeStarts[index].y) || (rangeEnd.x != m_layout.rangeEnds[index].x) || (rangeEnd.y != m_layout.rangeEnds[index].y) };
+		bool isChanged{ (index >= previousFramesSize) || isNumberOfGenericsChanged };
+		isChanged = isChanged ||
+			priv_isDifferent(m_previousLayout.starts[index].x, m_layout.starts[index].x, epsilon) ||
+			priv_isDifferent(m_previousLayout.starts[index].y, m_layout.starts[index].y, epsilon) ||
+			priv_isDifferent(m_previousLayout.ends[index].x, m_layout.ends[index].x, epsilon) ||
+			priv_isDifferent(m_previousLayout.ends[index].y, m_layout.ends[index].y, epsilon) ||
+			priv_isDifferent(m_previousLayout.clipStarts[index].x, m_layout.clipStarts[index].x, epsilon) ||
+			priv_isDifferent(m_previousLayout.clipStarts[index].y, m_layout.clipStarts[index].y, epsilon) ||
+			priv_isDifferent(m_previousLayout.clipEnds[index].x, m_layout.clipEnds[index].x, epsilon) ||
+			priv_isDifferent(m_previousLayout.clipEnds[index].y, m_layout.clipEnds[index].y, epsilon);
+		for (std::size_t g{ 0u }; g < m_numOfGenerics; ++g)
 		{
-			if (m_frames[i].groupId == groupId)
-				frames.push_back(i);
+			const std::size_t genericValueIndex{ (index * m_numOfGenerics) + g };
+			if (isResolveNeeded && !isCompareOnly && (m_previousLayout.generics[genericValueIndex] != m_layout.generics[genericValueIndex]))
+				isRangeChanged = true; // children's generics depend on their parent's generics
+			if (priv_isDifferent(m_previousLayout.generics[genericValueIndex], m_layout.generics[genericValueIndex], epsilon))
+				isChanged = true;
 		}
+
+		if (isRangeChanged)
+			m_frameStates[index] |= frameStateRangeChanged;
+		if (isClipChanged)
+			m_frameStates[index] |= frameStateClipChanged;
+		if (isChanged)
+			m_frameStates[index] |= frameStateChanged;
 	}
 
-	return frames;
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	{
+		if ((m_frameStates[i] & frameStateChanged) != 0u)
+			m_changedFrames.push_back(i);
+		m_frameStates[i] &= ~(frameStateDirty | frameStateRangeChanged | frameStateCompare | frameStateClipChanged);
+	}
+	m_isLayoutUpdated = true;
+
+	if (m_changeCallback)
+	{
+		for (auto& index : m_changedFrames)
+			m_changeCallback(index);
+	}
+
+	return m_changedFrames;
 }
 
-std::vector<std::size_t> Design::getFramesAtDepth(const int depth) const
+template <class T>
+std::size_t DesignBase<T>::exportFrames(void* const buffer, const std::size_t bufferSize, const ExportLayout& exportLayout) const
 {
-	std::vector<std::size_t> frames;
+	const std::size_t verticesPerFrame{ (exportLayout.type == ExportType::Quad) ? 4u : 1u };
+	if ((buffer == nullptr) || !priv_isValidExportLayout(exportLayout))
+		return 0u;
 
 	const std::size_t framesSize{ m_frames.size() };
-	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	const std::size_t numberOfFrames{ std::min(framesSize, bufferSize / (exportLayout.stride * verticesPerFrame)) };
+	unsigned char* destination{ static_cast<unsigned char*>(buffer) };
+	for (std::size_t i{ 0u }; i < numberOfFrames; ++i, destination += exportLayout.stride * verticesPerFrame)
+		priv_exportFrame(destination, i, exportLayout);
+
+	return numberOfFrames;
+}
+
+template <class T>
+std::size_t DesignBase<T>::exportFrames(void* const buffer, const std::size_t bufferSize, const ExportLayout& exportLayout, const IndexRange indices) const
+{
+	const std::size_t verticesPerFrame{ (exportLayout.type == ExportType::Quad) ? 4u : 1u };
+	if ((buffer == nullptr) || !priv_isValidExportLayout(exportLayout))
+		return 0u;
+
+	const std::size_t maximumNumberOfFrames{ bufferSize / (exportLayout.stride * verticesPerFrame) };
+	std::size_t numberOfFrames{ 0u };
+	unsigned char* destination{ static_cast<unsigned char*>(buffer) };
+	for (const std::size_t index : indices)
 	{
-		if (m_frames[i].depth == depth)
-			frames.push_back(i);
+		if (numberOfFrames == maximumNumberOfFrames)
+			break;
+		if (!priv_isValidFrameIndex(index))
+			continue;
+
+		priv_exportFrame(destination, index, exportLayout);
+		destination += exportLayout.stride * verticesPerFrame;
+		++numberOfFrames;
 	}
 
-	return frames;
+	return numberOfFrames;
 }
 
-std::vector<std::size_t> Design::getFramesInDepthRange(const int depthMin, const int depthMax, const bool useInsideRange, const bool sortAscending) const
+template <class T>
+std::size_t DesignBase<T>::addVariant(const Vector2 minimumRootSize)
 {
-	std::vector<std::size_t> frames;
+	Variant variant{ getMemoryResource() };
+	variant.minimumRootSize = minimumRootSize;
+	variant.offsets = m_offsets;
+	variant.genericValues = m_genericValues;
+	variant.genericLayouts = m_genericLayouts;
+	variant.layout = m_layout; // identical to the active variant so the cache is also valid
+	variant.isLayoutValid = m_isLayoutUpdated;
+	variant.structureVersion = m_structureVersion;
+	m_variants.push_back(std::move(variant));
+	return m_variants.size() - 1u;
+}
 
+template <class T>
+void DesignBase<T>::selectVariant(const std::size_t variantIndex)
+{
+	if ((variantIndex >= m_variants.size()) || (variantIndex == m_activeVariant))
+		return;
+
+	Variant& outgoing{ m_variants[m_activeVariant] };
+	Variant& incoming{ m_variants[variantIndex] };
+
+	// store the active values in the outgoing variant and take the incoming variant's values (no copying while they share a memory resource)
+	std::swap(outgoing.offsets, m_offsets);
+	std::swap(outgoing.genericValues, m_genericValues);
+	std::swap(outgoing.genericLayouts, m_genericLayouts);
+	std::swap(m_offsets, incoming.offsets);
+	std::swap(m_genericValues, incoming.genericValues);
+	std::swap(m_genericLayouts, incoming.genericLayouts);
+
+	// keep the current layout as the previous values so that update can report which frames moved
+	outgoing.layout = m_layout;
+	outgoing.isLayoutValid = m_isLayoutUpdated;
+	outgoing.structureVersion = m_structureVersion;
+	m_previousLayout = m_layout;
+
+	const bool isIncomingLayoutValid{ incoming.isLayoutValid && (incoming.structureVersion == m_structureVersion) };
+	if (isIncomingLayoutValid)
+		std::swap(m_layout, incoming.layout);
+	incoming.layout = Layout{ getMemoryResource() };
+	incoming.isLayoutValid = false;
+
+	for (auto& frameState : m_frameStates)
+		frameState = isIncomingLayoutValid ? frameStateCompare : (frameStateCompare | frameStateDirty);
+
+	// root frames carry their offsets over
 	const std::size_t framesSize{ m_frames.size() };
 	for (std::size_t i{ 0u }; i < framesSize; ++i)
 	{
-		if (useInsideRange == (m_frames[i].groupId >= depthMin) && (m_frames[i].groupId <= depthMax))
-			frames.push_back(i);
+		if (priv_isValidFrameIndex(m_frames[i].parentIndex))
+			continue;
+
+		const Offsets& root{ outgoing.offsets[i] };
+		Offsets& offsets{ m_offsets[i] };
+		if ((offsets.start.x != root.start.x) || (offsets.start.y != root.start.y) || (offsets.end.x != root.end.x) || (offsets.end.y != root.end.y) || (offsets.layout != root.layout))
+		{
+			offsets = root;
+			m_frameStates[i] |= frameStateDirty;
+		}
 	}
 
-	auto depthSortFunction = [&](std::size_t lhs, std::size_t rhs)
+	m_activeVariant = variantIndex;
+	m_isLayoutUpdated = false;
+	m_snapshotChunks.clear();
+}
+
+template <class T>
+std::size_t DesignBase<T>::selectVariantForRootSize(const Vector2 rootSize)
+{
+	std::size_t selected{ 0u };
+	bool isFound{ false };
+	const std::size_t variantsSize{ m_variants.size() };
+	for (std::size_t v{ 0u }; v < variantsSize; ++v)
 	{
-		if (m_frames[lhs].depth == m_frames[rhs].depth)
-			return sortAscending == (lhs < rhs);
-		else
-			return m_frames[lhs].depth < m_frames[rhs].depth;
-	};
+		const Vector2 minimum{ m_variants[v].minimumRootSize };
+		if ((rootSize.x < minimum.x) || (rootSize.y < minimum.y))
+			continue;
+
+		const Vector2 best{ m_variants[selected].minimumRootSize };
+		if (!isFound || (minimum.x > best.x) || ((minimum.x == best.x) && (minimum.y > best.y)))
+			selected = v;
+		isFound = true;
+	}
 
-	if (sortAscending)
-		std::sort(frames.begin(), frames.end(), depthSortFunction);
-	else
-		std::sort(frames.rbegin(), frames.rend(), depthSortFunction);
+	selectVariant(selected);
+	return m_activeVariant;
+}
 
-	return frames;
+template <class T>
+void DesignBase<T>::removeVariants()
+{
+	Variant base{ getMemoryResource() };
+	base.minimumRootSize = m_variants[m_activeVariant].minimumRootSize;
+	m_variants.clear();
+	m_variants.push_back(std::move(base));
+	m_activeVariant = 0u;
 }
 
-std::vector<std::size_t> Design::getFramesToDepth(const int depth, const bool useBelow, const bool sortAscending) const
+template <class T>
+void DesignBase<T>::addKeyframe(const std::size_t trackIndex, const T time, const T value, const Easing easing)
 {
-	std::vector<std::size_t> frames;
+	if (trackIndex >= m_animationTracks.size())
+		return;
+
+	// keyframes with the same time stay in the order they were added
+	std::pmr::vector<Keyframe>& keyframes{ m_animationTracks[trackIndex].keyframes };
+	const auto position{ std::upper_bound(keyframes.begin(), keyframes.end(), time, [](const T lhs, const Keyframe& rhs) { return lhs < rhs.time; }) };
+	keyframes.insert(position, { time, value, easing });
+	m_animationTracks[trackIndex].nextKeyframe = 0u;
+}
 
-	const std::size_t framesSize{ m_frames.size() };
-	for (std::size_t i{ 0u }; i < framesSize; ++i)
+template <class T>
+void DesignBase<T>::animate(const T time)
+{
+	const std::size_t animationTracksSize{ m_animationTracks.size() };
+	m_animationValues.starts.resize(animationTracksSize);
+	m_animationValues.differences.resize(animationTracksSize);
+	m_animationValues.progresses.resize(animationTracksSize);
+	m_animationValues.results.resize(animationTracksSize);
+
+	const T zero{};
+	const T one{ static_cast<T>(1) };
+	const T two{ static_cast<T>(2) };
+	const T three{ static_cast<T>(3) };
+
+	// find each track's current pair of keyframes and its (eased) progress between them
+	for (std::size_t t{ 0u }; t < animationTracksSize; ++t)
 	{
-		if ((m_frames[i].depth == depth) || (useBelow == (m_frames[i].depth < depth)))
-			frames.push_back(i);
+		AnimationTrack& track{ m_animationTracks[t] };
+		const std::pmr::vector<Keyframe>& keyframes{ track.keyframes };
+		const std::size_t keyframesSize{ keyframes.size() };
+		if (keyframesSize == 0u)
+		{
+			m_animationValues.starts[t] = zero;
+			m_animationValues.differences[t] = zero;
+			m_animationValues.progresses[t] = zero;
+			continue;
+		}
+
+		std::size_t next{ std::min(track.nextKeyframe, keyframesSize) };
+		while ((next < keyframesSize) && !(time < keyframes[next].time))
+			++next;
+		while ((next > 0u) && (time < keyframes[next - 1u].time))
+			--next;
+		track.nextKeyframe = next;
+
+		if ((next == 0u) || (next == keyframesSize))
+		{
+			m_animationValues.starts[t] = keyframes[(next == 0u) ? 0u : (keyframesSize - 1u)].value;
+			m_animationValues.differences[t] = zero;
+			m_animationValues.progresses[t] = zero;
+			continue;
+		}
+
+		const Keyframe& from{ keyframes[next - 1u] };
+		const Keyframe& to{ keyframes[next] };
+		T progress{ (time - from.time) / (to.time - from.time) };
+		switch (to.easing)
+		{
+		case Easing::Linear:
+			break;
+		case Easing::In:
+			progress = progress * progress;
+			break;
+		case Easing::Out:
+			progress = progress * (two - progress);
+			break;
+		case Easing::InOut:
+			progress = progress * progress * (three - (two * progress));
+			break;
+		case Easing::Step:
+			progress = zero;
+			break;
+		}
+		m_animationValues.starts[t] = from.value;
+		m_animationValues.differences[t] = to.value - from.value;
+		m_animationValues.progresses[t] = (progress < zero) ? zero : ((progress > one) ? one : progress);
 	}
 
-	auto depthSortFunction = [&](std::size_t lhs, std::size_t rhs)
+	// interpolate all tracks together (branch-free so it can be vectorised by the compiler)
+	const T* const starts{ m_animationValues.starts.data() };
+	const T* const differences{ m_animationValues.differences.data() };
+	const T* const progresses{ m_animationValues.progresses.data() };
+	T* const results{ m_animationValues.results.data() };
+	for (std::size_t t{ 0u }; t < animationTracksSize; ++t)
+		results[t] = starts[t] + (differences[t] * progresses[t]);
+
+	// only values that change are written so that unchanged frames stay resolved
+	for (std::size_t t{ 0u }; t < animationTracksSize; ++t)
 	{
-		if (m_frames[lhs].depth == m_frames[rhs].depth)
-			return sortAscending == (lhs < rhs);
-		else
-			return m_frames[lhs].depth < m_frames[rhs].depth;
+		const AnimationTrack& track{ m_animationTracks[t] };
+		if (track.keyframes.empty() || !priv_isValidFrameIndex(track.index))
+			continue;
+
+		T* value{ nullptr };
+		Offsets& offsets{ m_offsets[track.index] };
+		switch (track.target)
+		{
+		case AnimationTarget::StartX:
+			value = &offsets.start.x;
+			break;
+		case AnimationTarget::StartY:
+			value = &offsets.start.y;
+			break;
+		case AnimationTarget::EndX:
+			value = &offsets.end.x;
+			break;
+		case AnimationTarget::EndY:
+			value = &offsets.end.y;
+			break;
+		case AnimationTarget::Generic:
+			if (track.genericIndex < m_numOfGenerics)
+				value = &m_genericValues[(track.index * m_numOfGenerics) + track.genericIndex];
+			break;
+		}
+		if ((value == nullptr) || (*value == results[t]))
+			continue;
+
+		*value = results[t];
+		priv_invalidate(track.index);
+	}
+}
+
+template <class T>
+void DesignBase<T>::resolveViewports(const std::size_t rootIndex, const std::vector<Rectangle>& viewports, std::vector<ResolvedLayout>& results)
+{
+	const std::size_t framesSize{ priv_isValidFrameIndex(rootIndex) ? m_frames.size() : 0u }; // results are emptied if there is no root
+	const std::size_t numberOfViewports{ viewports.size() };
+	results.resize(numberOfViewports);
+	for (auto& result : results)
+	{
+		result.m_starts.resize(framesSize);
+		result.m_ends.resize(framesSize);
+		result.m_generics.resize(framesSize * m_numOfGenerics);
+		result.m_numOfGenerics = m_numOfGenerics;
+		result.m_requestNumber = 0u;
+	}
+	if ((numberOfViewports == 0u) || (framesSize == 0u))
+		return;
+
+	if (m_isResolveOrderDirty)
+		priv_updateResolveOrder();
+
+	ViewportValues& values{ m_viewportValues };
+	values.rangeStartsX.resize(framesSize * numberOfViewports);
+	values.rangeStartsY.resize(framesSize * numberOfViewports);
+	values.rangeEndsX.resize(framesSize * numberOfViewports);
+	values.rangeEndsY.resize(framesSize * numberOfViewports);
+	values.generics.resize(framesSize * m_numOfGenerics * numberOfViewports);
+	values.startsX.resize(numberOfViewports);
+	values.startsY.resize(numberOfViewports);
+	values.endsX.resize(numberOfViewports);
+	values.endsY.resize(numberOfViewports);
+
+	// the inner loops are over viewports and are branch-free so they can be vectorised by the compiler
+	auto apply = [numberOfViewports](const LinearComponent component, const T* const parentStarts, const T* const parentEnds, T* const destination)
+	{
+		const T parentStartScale{ component.parentStartScale };
+		const T parentEndScale{ component.parentEndScale };
+		const T offset{ component.offset };
+		for (std::size_t v{ 0u }; v < numberOfViewports; ++v)
+			destination[v] = (parentStartScale * parentStarts[v]) + (parentEndScale * parentEnds[v]) + offset;
+	};
+	auto fill = [numberOfViewports](const T value, T* const destination)
+	{
+		for (std::size_t v{ 0u }; v < numberOfViewports; ++v)
+			destination[v] = value;
+	};
+	auto copy = [numberOfViewports](const T* const source, T* const destination)
+	{
+		for (std::size_t v{ 0u }; v < numberOfViewports; ++v)
+			destination[v] = source[v];
 	};
 
-	if (sortAscending)
-		std::sort(frames.begin(), frames.end(), depthSortFunction);
-	else
-		std::sort(frames.rbegin(), frames.rend(), depthSortFunction);
+	for (auto& index : m_resolveOrder)
+	{
+		const int parentIndex{ m_frames[index].parentIndex };
+		const bool hasParent{ priv_isValidFrameIndex(parentIndex) };
+		const bool isPoint{ priv_isPoint(index) };
 
-	return frames;
+		for (const ComponentType componentType : { ComponentType::X, ComponentType::Y })
+		{
+			const bool isX{ componentType == ComponentType::X };
+			T* const starts{ isX ? values.startsX.data() : values.startsY.data() };
+			T* const ends{ isX ? values.endsX.data() : values.endsY.data() };
+			T* const rangeStarts{ (isX ? values.rangeStartsX.data() : values.rangeStartsY.data()) + (index * numberOfViewports) };
+			T* const rangeEnds{ (isX ? values.rangeEndsX.data() : values.rangeEndsY.data()) + (index * numberOfViewports) };
+			const Property startProperty{ priv_getProperty(index, ValueType::Start, componentType) };
+			const Property endProperty{ priv_getProperty(index, ValueType::End, componentType) };
+
+			if (index == rootIndex)
+			{
+				for (std::size_t v{ 0u }; v < numberOfViewports; ++v)
+				{
+					rangeStarts[v] = isX ? viewports[v].start.x : viewports[v].start.y;
+					rangeEnds[v] = isX ? viewports[v].end.x : viewports[v].end.y;
+				}
+				copy(rangeStarts, starts);
+				copy(isPoint ? rangeStarts : rangeEnds, ends);
+			}
+			else if (!hasParent)
+			{
+				fill(startProperty.value, starts);
+				fill(isPoint ? startProperty.value : endProperty.value, ends);
+				fill(startProperty.value, rangeStarts);
+				fill(endProperty.value, rangeEnds);
+			}
+			else
+			{
+				// matches priv_resolveFrame
+				const T* const parentStarts{ (isX ? values.rangeStartsX.data() : values.rangeStartsY.data()) + (parentIndex * numberOfViewports) };
+				const T* const parentEnds{ (isX ? values.rangeEndsX.data() : values.rangeEndsY.data()) + (parentIndex * numberOfViewports) };
+				apply(priv_getLinearComponent(startProperty, ValueType::Start, endProperty), parentStarts, parentEnds, starts);
+				if (isPoint)
+					copy(starts, ends);
+				else
+					apply(priv_getLinearComponent(endProperty, ValueType::End, startProperty), parentStarts, parentEnds, ends);
+				apply(priv_getLinearComponent(startProperty, ValueType::Start, Property{}), parentStarts, parentEnds, rangeStarts);
+				apply(priv_getLinearComponent(endProperty, ValueType::End, Property{}), parentStarts, parentEnds, rangeEnds);
+			}
+		}
+
+		for (std::size_t v{ 0u }; v < numberOfViewports; ++v)
+		{
+			results[v].m_starts[index] = { values.startsX[v], values.startsY[v] };
+			results[v].m_ends[index] = { values.endsX[v], values.endsY[v] };
+		}
+
+		for (std::size_t g{ 0u }; g < m_numOfGenerics; ++g)
+		{
+			const std::size_t genericValueIndex{ (index * m_numOfGenerics) + g };
+			const Property generic{ priv_getProperty(index, ValueType::Generic, ComponentType::X, g) };
+			T* const generics{ values.generics.data() + (genericValueIndex * numberOfViewports) };
+			if (!hasParent || ((generic.relation == RelationType::Absolute) && (generic.anchor != AnchorPoint::Size)))
+				fill(generic.value, generics);
+			else
+			{
+				const T* const parentGenerics{ values.generics.data() + (((parentIndex * m_numOfGenerics) + g) * numberOfViewports) };
+				const bool isScale{ generic.relation == RelationType::Scale };
+				const T scale{ isScale ? generic.value : static_cast<T>(1) };
+				const T offset{ isScale ? T{} : generic.value };
+				for (std::size_t v{ 0u }; v < numberOfViewports; ++v)
+					generics[v] = (scale * parentGenerics[v]) + offset;
+			}
+			for (std::size_t v{ 0u }; v < numberOfViewports; ++v)
+				results[v].m_generics[genericValueIndex] = generics[v];
+		}
+	}
 }
 
-std::vector<std::size_t> Design::getFramesAtAllDepths(const bool sortAscending) const
+template <class T>
+void DesignBase<T>::compileLayout(LayoutProgram& program)
 {
-	std::vector<std::size_t> frames(m_frames.size());
+	if (m_isResolveOrderDirty)
+		priv_updateResolveOrder();
 
 	const std::size_t framesSize{ m_frames.size() };
-	for (std::size_t i{ 0u }; i < framesSize; ++i)
-		frames[i] = i;
+	program.m_numOfGenerics = m_numOfGenerics;
+	program.m_instructions.clear();
+	program.m_genericTransforms.clear();
+	program.m_instructionIndices.resize(framesSize);
+	program.m_starts.assign(framesSize, { T{}, T{} });
+	program.m_ends.assign(framesSize, { T{}, T{} });
+	program.m_rangeStarts.assign(framesSize + 1u, { T{}, T{} });
+	program.m_rangeEnds.assign(framesSize + 1u, { T{}, T{} });
+	program.m_generics.assign((framesSize + 1u) * m_numOfGenerics, T{});
+
+	// matches priv_resolveFrame. root frames have a zero parent range so their factors are always zero and their values are the offsets
+	const T zero{};
+	const T one{ static_cast<T>(1) };
+	for (auto& index : m_resolveOrder)
+	{
+		const int parentIndex{ m_frames[index].parentIndex };
+		const bool hasParent{ priv_isValidFrameIndex(parentIndex) };
+		const bool isPoint{ priv_isPoint(index) };
+
+		typename LayoutProgram::Instruction instruction;
+		instruction.index = index;
+		instruction.parentIndex = hasParent ? static_cast<std::size_t>(parentIndex) : framesSize;
+		instruction.isPoint = isPoint;
+		for (const ComponentType componentType : { ComponentType::X, ComponentType::Y })
+		{
+			const bool isX{ componentType == ComponentType::X };
+			const Property startProperty{ priv_getProperty(index, ValueType::Start, componentType) };
+			const Property endProperty{ priv_getProperty(index, ValueType::End, componentType) };
+			LinearComponent& start{ isX ? instruction.startX : instruction.startY };
+			LinearComponent& end{ isX ? instruction.endX : instruction.endY };
+			LinearComponent& rangeStart{ isX ? instruction.rangeStartX : instruction.rangeStartY };
+			LinearComponent& rangeEnd{ isX ? instruction.rangeEndX : instruction.rangeEndY };
+
+			if (!hasParent)
+			{
+				start = { zero, zero, startProperty.value };
+				end = { zero, zero, isPoint ? startProperty.value : endProperty.value };
+				rangeStart = { zero, zero, startProperty.value };
+				rangeEnd = { zero, zero, endProperty.value };
+				continue;
+			}
+
+			start = priv_getLinearComponent(startProperty, ValueType::Start, endProperty);
+			end = isPoint ? start : priv_getLinearComponent(endProperty, ValueType::End, startProperty);
+			rangeStart = priv_getLinearComponent(startProperty, ValueType::Start, Property{});
+			rangeEnd = priv_getLinearComponent(endProperty, ValueType::End, Property{});
+		}
+		program.m_instructionIndices[index] = program.m_instructions.size();
+		program.m_instructions.push_back(instruction);
 
-	auto depthSortFunction = [&](std::size_t lhs, std::size_t rhs)
+		for (std::size_t g{ 0u }; g < m_numOfGenerics; ++g)
+		{
+			const Property generic{ priv_getProperty(index, ValueType::Generic, ComponentType::X, g) };
+			if (!hasParent || ((generic.relation == RelationType::Absolute) && (generic.anchor != AnchorPoint::Size)))
+				program.m_genericTransforms.push_back({ zero, generic.value });
+			else if (generic.relation == RelationType::Scale)
+				program.m_genericTransforms.push_back({ generic.value, zero });
+			else
+				program.m_genericTransforms.push_back({ one, generic.value });
+		}
+	}
+}
+
+template <class T>
+typename DesignBase<T>::Patch DesignBase<T>::getPatch(const DesignBase& target) const
+{
+	Patch patch;
+	const std::size_t framesSize{ m_frames.size() };
+	const std::size_t targetFramesSize{ target.m_frames.size() };
+	const std::size_t numOfGenerics{ target.m_numOfGenerics };
+	patch.m_numberOfFrames = targetFramesSize;
+	patch.m_numOfGenerics = numOfGenerics;
+	patch.m_isNumberOfFramesChanged = (targetFramesSize != framesSize);
+	patch.m_isNumberOfGenericsChanged = (numOfGenerics != m_numOfGenerics);
+
+	// new frames (and every frame if the number of generics is different) are always included
+	for (std::size_t i{ 0u }; i < targetFramesSize; ++i)
 	{
-		if (m_frames[lhs].depth == m_frames[rhs].depth)
-			return sortAscending == (lhs < rhs);
-		else
-			return m_frames[lhs].depth < m_frames[rhs].depth;
-	};
+		const Frame& targetFrame{ target.m_frames[i] };
+		const Offsets& targetOffsets{ target.m_offsets[i] };
+		bool isDifferent{ (i >= framesSize) || patch.m_isNumberOfGenericsChanged };
+		if (!isDifferent)
+		{
+			const Frame& frame{ m_frames[i] };
+			const Offsets& offsets{ m_offsets[i] };
+			isDifferent =
+				(frame.parentIndex != targetFrame.parentIndex) || (frame.groupId != targetFrame.groupId) || (frame.depth != targetFrame.depth) ||
+				(offsets.start.x != targetOffsets.start.x) || (offsets.start.y != targetOffsets.start.y) ||
+				(offsets.end.x != targetOffsets.end.x) || (offsets.end.y != targetOffsets.end.y) ||
+				(offsets.layout != targetOffsets.layout);
+			for (std::size_t g{ 0u }; (g < numOfGenerics) && !isDifferent; ++g)
+			{
+				const std::size_t genericValueIndex{ (i * numOfGenerics) + g };
+				isDifferent = (m_genericValues[genericValueIndex] != target.m_genericValues[genericValueIndex]) || (m_genericLayouts[genericValueIndex] != target.m_genericLayouts[genericValueIndex]);
+			}
+		}
+		if (!isDifferent)
+			continue;
 
-	if (sortAscending)
-		std::sort(frames.begin(), frames.end(), depthSortFunction);
-	else
-		std::sort(frames.rbegin(), frames.rend(), depthSortFunction);
+		patch.m_changes.push_back({ i, targetFrame, targetOffsets });
+		patch.m_genericValues.insert(patch.m_genericValues.end(), target.m_genericValues.begin() + (i * numOfGenerics), target.m_genericValues.begin() + ((i + 1u) * numOfGenerics));
+		patch.m_genericLayouts.insert(patch.m_genericLayouts.end(), target.m_genericLayouts.begin() + (i * numOfGenerics), target.m_genericLayouts.begin() + ((i + 1u) * numOfGenerics));
+	}
 
-	return frames;
+	return patch;
+}
+
+template <class T>
+void DesignBase<T>::applyPatch(const Patch& patch)
+{
+	if (patch.m_numOfGenerics != m_numOfGenerics)
+		resizeGenerics(patch.m_numOfGenerics);
+	if (patch.m_numberOfFrames < m_frames.size())
+		priv_removeFramesFrom(patch.m_numberOfFrames);
+	while (m_frames.size() < patch.m_numberOfFrames)
+		priv_addFrame(); // its values are included in the patch
+
+	// only the changed frames are invalidated. update then also resolves their children
+	const std::size_t changesSize{ patch.m_changes.size() };
+	for (std::size_t c{ 0u }; c < changesSize; ++c)
+	{
+		const typename Patch::Change& change{ patch.m_changes[c] };
+		priv_setFrameValues(change.index, change.frame, change.offsets, patch.m_genericValues.data() + (c * m_numOfGenerics), patch.m_genericLayouts.data() + (c * m_numOfGenerics));
+	}
+}
+
+template <class T>
+typename DesignBase<T>::Snapshot DesignBase<T>::takeSnapshot()
+{
+	const std::size_t framesSize{ m_frames.size() };
+	const std::size_t chunksSize{ (framesSize + framesPerSnapshotChunk - 1u) / framesPerSnapshotChunk };
+	m_snapshotChunks.resize(chunksSize);
+
+	// only the chunks changed since the previous snapshot are copied. all others are shared
+	for (std::size_t c{ 0u }; c < chunksSize; ++c)
+	{
+		if (m_snapshotChunks[c])
+			continue;
+
+		const std::size_t first{ c * framesPerSnapshotChunk };
+		const std::size_t last{ std::min(first + framesPerSnapshotChunk, framesSize) };
+		std::shared_ptr<SnapshotChunk> chunk{ std::make_shared<SnapshotChunk>() };
+		chunk->frames.assign(m_frames.begin() + first, m_frames.begin() + last);
+		chunk->offsets.assign(m_offsets.begin() + first, m_offsets.begin() + last);
+		chunk->genericValues.assign(m_genericValues.begin() + (first * m_numOfGenerics), m_genericValues.begin() + (last * m_numOfGenerics));
+		chunk->genericLayouts.assign(m_genericLayouts.begin() + (first * m_numOfGenerics), m_genericLayouts.begin() + (last * m_numOfGenerics));
+		m_snapshotChunks[c] = std::move(chunk);
+	}
+
+	Snapshot snapshot;
+	snapshot.m_chunks.assign(m_snapshotChunks.begin(), m_snapshotChunks.end());
+	snapshot.m_numberOfFrames = framesSize;
+	snapshot.m_numOfGenerics = m_numOfGenerics;
+	return snapshot;
 }
 
+template <class T>
+void DesignBase<T>::restoreSnapshot(const Snapshot& snapshot)
+{
+	if (snapshot.m_numOfGenerics != m_numOfGenerics)
+		resizeGenerics(snapshot.m_numOfGenerics);
+	if (snapshot.m_numberOfFrames < m_frames.size())
+		priv_removeFramesFrom(snapshot.m_numberOfFrames);
+	while (m_frames.size() < snapshot.m_numberOfFrames)
+		priv_addFrame(); // its values are restored from its chunk
+
+	// a chunk that the design still shares with the snapshot already matches. in other chunks, only the frames that differ are changed (and invalidated)
+	const std::size_t chunksSize{ snapshot.m_chunks.size() };
+	m_snapshotChunks.resize(chunksSize);
+	for (std::size_t c{ 0u }; c < chunksSize; ++c)
+	{
+		const std::shared_ptr<const SnapshotChunk>& chunk{ snapshot.m_chunks[c] };
+		if (m_snapshotChunks[c] == chunk)
+			continue;
 
+		const std::size_t first{ c * framesPerSnapshotChunk };
+		const std::size_t chunkSize{ chunk->frames.size() };
+		for (std::size_t f{ 0u }; f < chunkSize; ++f)
+			priv_setFrameValues(first + f, chunk->frames[f], chunk->offsets[f], chunk->genericValues.data() + (f * m_numOfGenerics), chunk->genericLayouts.data() + (f * m_numOfGenerics));
+
+		// the frames now match the chunk so it is shared again
+		m_snapshotChunks[c] = chunk;
+	}
+}
 
 
 
@@ -311,38 +1218,51 @@ std::vector<std::size_t> Design::getFramesAtAllDepths(const bool sortAscending)
 
 // PRIVATE
 
-float Design::priv_unpackComponent(Property property, const ValueType valueType, const int parentIndex, const ComponentType componentType, const std::size_t genericIndex, Property oppositeProperty) const
+template <class T>
+T DesignBase<T>::priv_unpackComponent(Property property, const ValueType valueType, const int parentIndex, const ComponentType componentType, const std::size_t genericIndex, Property oppositeProperty) const
 {
 	if ((parentIndex == -1) || ((property.relation == RelationType::Absolute) && (property.anchor != AnchorPoint::Size)))
 		return property.value;
 
-	const bool isX{ componentType == ComponentType::X };
-	const bool isScaled{ property.relation == RelationType::Scale };
-
 	const Frame& parent{ m_frames[parentIndex] };
 
-	const float parentStart{ priv_unpackComponent(isX ? parent.start.x : parent.start.y, ValueType::Start, parent.parentIndex, componentType, genericIndex) };
-	const float parentEnd{ priv_unpackComponent(isX ? parent.end.x : parent.end.y, ValueType::End, parent.parentIndex, componentType, genericIndex) };
-	const float parentRange{ parentEnd - parentStart };
-
-	float result{ property.value };
-
 	if (valueType == ValueType::Generic)
 	{
-		if (isScaled)
-			return result * priv_unpackComponent(parent.generics[genericIndex], ValueType::Generic, parent.parentIndex, componentType, genericIndex);
+		if (property.relation == RelationType::Scale)
+			return property.value * priv_unpackComponent(priv_getProperty(parentIndex, ValueType::Generic, ComponentType::X, genericIndex), ValueType::Generic, parent.parentIndex, componentType, genericIndex);
 		else
-			return result + priv_unpackComponent(parent.generics[genericIndex], ValueType::Generic, parent.parentIndex, componentType, genericIndex);
+			return property.value + priv_unpackComponent(priv_getProperty(parentIndex, ValueType::Generic, ComponentType::X, genericIndex), ValueType::Generic, parent.parentIndex, componentType, genericIndex);
 	}
-	else if (isScaled)
-		result *= parentRange;
+
+	const T parentStart{ priv_unpackComponent(priv_getProperty(parentIndex, ValueType::Start, componentType), ValueType::Start, parent.parentIndex, componentType, genericIndex) };
+	const T parentEnd{ priv_unpackComponent(priv_getProperty(parentIndex, ValueType::End, componentType), ValueType::End, parent.parentIndex, componentType, genericIndex) };
+
+	return priv_resolveComponent(property, valueType, { parentStart, parentEnd }, oppositeProperty);
+}
+
+template <class T>
+T DesignBase<T>::priv_resolveComponent(Property property, const ValueType valueType, const Range parentRange, Property oppositeProperty)
+{
+	if ((property.relation == RelationType::Absolute) && (property.anchor != AnchorPoint::Size))
+		return property.value;
+
+	const T parentStart{ parentRange.start };
+	const T parentEnd{ parentRange.end };
+	const T parentSize{ parentEnd - parentStart };
+
+	const T half{ static_cast<T>(0.5) };
+
+	T result{ property.value };
+
+	if (property.relation == RelationType::Scale)
+		result *= parentSize;
 
 	switch (property.anchor)
 	{
 	case AnchorPoint::Start:
 		return result + parentStart;
 	case AnchorPoint::Center:
-		return result + ((0.5f * parentStart) + (0.5f * parentEnd));
+		return result + ((half * parentStart) + (half * parentEnd));
 	case AnchorPoint::End:
 		return result + parentEnd;
 	case AnchorPoint::Size:
@@ -355,44 +1275,562 @@ float Design::priv_unpackComponent(Property property, const ValueType valueType,
 				property.anchor = AnchorPoint::Start;
 		}
 		if (property.relation == RelationType::Relative)
-			result += parentRange;
-		return result + priv_unpackComponent(oppositeProperty, valueType == ValueType::Start ? ValueType::End : ValueType::Start, parentIndex, componentType, genericIndex, property);
+			result += parentSize;
+		return result + priv_resolveComponent(oppositeProperty, valueType == ValueType::Start ? ValueType::End : ValueType::Start, parentRange, property);
 	default:
 		return result;
 	}
 }
 
-Vector2 Design::priv_getLocal(const std::size_t index, const ValueType valueType) const
+template <class T>
+typename DesignBase<T>::LinearComponent DesignBase<T>::priv_getLinearComponent(const Property property, const ValueType valueType, const Property oppositeProperty)
+{
+	// a resolved component is always a linear combination of its parent range's start and end so resolving it with unit ranges finds its factors
+	const T zero{};
+	const T one{ static_cast<T>(1) };
+	const T offset{ priv_resolveComponent(property, valueType, { zero, zero }, oppositeProperty) };
+	return{
+		priv_resolveComponent(property, valueType, { one, zero }, oppositeProperty) - offset,
+		priv_resolveComponent(property, valueType, { zero, one }, oppositeProperty) - offset,
+		offset };
+}
+
+template <class T>
+void DesignBase<T>::priv_resolveFrame(const std::size_t index, Layout& layout) const
+{
+	const int parentIndex{ m_frames[index].parentIndex };
+	const bool hasParent{ priv_isValidFrameIndex(parentIndex) };
+	const bool isPoint{ priv_isPoint(index) };
+
+	// matches priv_getLocalComponent (start/end) and priv_getRange (range) but uses the parent's resolved range instead of resolving it again
+	Vector2& start{ layout.starts[index] };
+	Vector2& end{ layout.ends[index] };
+	Vector2& rangeStart{ layout.rangeStarts[index] };
+	Vector2& rangeEnd{ layout.rangeEnds[index] };
+	for (const ComponentType componentType : { ComponentType::X, ComponentType::Y })
+	{
+		const bool isX{ componentType == ComponentType::X };
+		const Property startProperty{ priv_getProperty(index, ValueType::Start, componentType) };
+		const Property endProperty{ priv_getProperty(index, ValueType::End, componentType) };
+		T& startComponent{ isX ? start.x : start.y };
+		T& endComponent{ isX ? end.x : end.y };
+		T& rangeStartComponent{ isX ? rangeStart.x : rangeStart.y };
+		T& rangeEndComponent{ isX ? rangeEnd.x : rangeEnd.y };
+
+		if (!hasParent)
+		{
+			startComponent = startProperty.value;
+			endComponent = isPoint ? startProperty.value : endProperty.value;
+			rangeStartComponent = startProperty.value;
+			rangeEndComponent = endProperty.value;
+			continue;
+		}
+
+		const Range parentRange{ isX ? layout.rangeStarts[parentIndex].x : layout.rangeStarts[parentIndex].y, isX ? layout.rangeEnds[parentIndex].x : layout.rangeEnds[parentIndex].y };
+		startComponent = priv_resolveComponent(startProperty, ValueType::Start, parentRange, endProperty);
+		endComponent = isPoint ? startComponent : priv_resolveComponent(endProperty, ValueType::End, parentRange, startProperty);
+		rangeStartComponent = priv_resolveComponent(startProperty, ValueType::Start, parentRange, Property{});
+		rangeEndComponent = priv_resolveComponent(endProperty, ValueType::End, parentRange, Property{});
+	}
+
+	for (std::size_t g{ 0u }; g < m_numOfGenerics; ++g)
+	{
+		const Property generic{ priv_getProperty(index, ValueType::Generic, ComponentType::X, g) };
+		T& result{ layout.generics[(index * m_numOfGenerics) + g] };
+		if (!hasParent || ((generic.relation == RelationType::Absolute) && (generic.anchor != AnchorPoint::Size)))
+			result = generic.value;
+		else if (generic.relation == RelationType::Scale)
+			result = generic.value * layout.generics[(parentIndex * m_numOfGenerics) + g];
+		else
+			result = generic.value + layout.generics[(parentIndex * m_numOfGenerics) + g];
+	}
+}
+
+template <class T>
+bool DesignBase<T>::priv_resolveClip(const std::size_t index)
+{
+	const int parentIndex{ m_frames[index].parentIndex };
+	const bool hasParent{ priv_isValidFrameIndex(parentIndex) };
+	const int parentClipFrame{ hasParent ? m_layout.clipFrames[parentIndex] : -1 };
+
+	Vector2& clipStart{ m_layout.clipStarts[index] };
+	Vector2& clipEnd{ m_layout.clipEnds[index] };
+	const Vector2 previousClipStart{ clipStart };
+	const Vector2 previousClipEnd{ clipEnd };
+	const int previousClipFrame{ m_layout.clipFrames[index] };
+
+	// the parent's clip frame's clip rectangle is the intersection of all of the clipping ancestors so only that one is needed
+	clipStart = m_layout.starts[index];
+	clipEnd = m_layout.ends[index];
+	if (priv_isValidFrameIndex(parentClipFrame))
+	{
+		const Vector2 ancestorStart{ m_layout.clipStarts[parentClipFrame] };
+		const Vector2 ancestorEnd{ m_layout.clipEnds[parentClipFrame] };
+		clipStart = { std::max(clipStart.x, ancestorStart.x), std::max(clipStart.y, ancestorStart.y) };
+		clipEnd = { std::min(clipEnd.x, ancestorEnd.x), std::min(clipEnd.y, ancestorEnd.y) };
+	}
+
+	const bool isClippingChildren{ priv_isClippingChildren(index) };
+	m_layout.clipFrames[index] = isClippingChildren ? static_cast<int>(index) : parentClipFrame;
+	if (m_layout.clipFrames[index] != previousClipFrame)
+		return true;
+
+	// children are given this frame's clip rectangle if it clips them, otherwise the one that it was given
+	if (isClippingChildren)
+		return (clipStart.x != previousClipStart.x) || (clipStart.y != previousClipStart.y) || (clipEnd.x != previousClipEnd.x) || (clipEnd.y != previousClipEnd.y);
+	return hasParent && ((m_frameStates[parentIndex] & frameStateClipChanged) != 0u);
+}
+
+template <class T>
+void DesignBase<T>::priv_setFrameValues(const std::size_t index, const Frame& frame, const Offsets& offsets, const T* const genericValues, const std::uint8_t* const genericLayouts)
+{
+	// group and depth do not affect the layout
+	setGroup(index, frame.groupId);
+	setDepth(index, frame.depth);
+
+	Offsets& currentOffsets{ m_offsets[index] };
+	bool isDifferent{
+		(m_frames[index].parentIndex != frame.parentIndex) ||
+		(currentOffsets.start.x != offsets.start.x) || (currentOffsets.start.y != offsets.start.y) ||
+		(currentOffsets.end.x != offsets.end.x) || (currentOffsets.end.y != offsets.end.y) ||
+		(currentOffsets.layout != offsets.layout) };
+	for (std::size_t g{ 0u }; (g < m_numOfGenerics) && !isDifferent; ++g)
+	{
+		const std::size_t genericValueIndex{ (index * m_numOfGenerics) + g };
+		isDifferent = (m_genericValues[genericValueIndex] != genericValues[g]) || (m_genericLayouts[genericValueIndex] != genericLayouts[g]);
+	}
+	if (!isDifferent)
+		return;
+
+	if (m_frames[index].parentIndex != frame.parentIndex)
+	{
+		m_frames[index].parentIndex = frame.parentIndex;
+		m_isResolveOrderDirty = true;
+		m_isChildrenIndexDirty = true;
+		++m_structureVersion;
+	}
+	currentOffsets = offsets;
+	for (std::size_t g{ 0u }; g < m_numOfGenerics; ++g)
+	{
+		m_genericValues[(index * m_numOfGenerics) + g] = genericValues[g];
+		m_genericLayouts[(index * m_numOfGenerics) + g] = genericLayouts[g];
+	}
+	priv_invalidate(index); // update then also resolves its children
+}
+
+template <class T>
+bool DesignBase<T>::priv_isValidExportLayout(const ExportLayout& exportLayout) const
+{
+	const std::size_t stride{ exportLayout.stride };
+	const std::size_t scalarSize{ (exportLayout.type == ExportType::PixelRectangle) ? sizeof(std::int16_t) : sizeof(T) };
+	if ((stride == 0u) ||
+		!isExportValueInStride(exportLayout.positionOffset, scalarSize * 2u, stride) ||
+		!isExportValueInStride(exportLayout.depthOffset, scalarSize, stride) ||
+		((exportLayout.type != ExportType::Quad) && !isExportValueInStride(exportLayout.sizeOffset, scalarSize * 2u, stride)))
+		return false;
+
+	// generics that the design does not have are not written
+	for (auto& generic : exportLayout.generics)
+	{
+		if ((generic.genericIndex < m_numOfGenerics) && !isExportValueInStride(generic.offset, sizeof(T), stride))
+			return false;
+	}
+	return true;
+}
+
+template <class T>
+void DesignBase<T>::priv_exportFrame(unsigned char* const destination, const std::size_t index, const ExportLayout& exportLayout) const
+{
+	const Vector2 start{ getStartAbsolute(index) };
+	const Vector2 end{ getEndAbsolute(index) };
+	const T depth{ static_cast<T>(m_frames[index].depth) };
+
+	auto writeGenerics = [&](unsigned char* const target)
+	{
+		for (auto& generic : exportLayout.generics)
+		{
+			if (generic.genericIndex < m_numOfGenerics)
+				writeExportValue(target, generic.offset, getGenericAbsolute(index, generic.genericIndex));
+		}
+	};
+
+	switch (exportLayout.type)
+	{
+	case ExportType::Quad:
+		{
+			const Vector2 corners[4u]{ start, { end.x, start.y }, end, { start.x, end.y } };
+			for (std::size_t v{ 0u }; v < 4u; ++v)
+			{
+				unsigned char* const vertex{ destination + (v * exportLayout.stride) };
+				writeExportVector(vertex, exportLayout.positionOffset, corners[v].x, corners[v].y);
+				writeExportValue(vertex, exportLayout.depthOffset, depth);
+				writeGenerics(vertex);
+			}
+		}
+		break;
+	case ExportType::Rectangle:
+		writeExportVector(destination, exportLayout.positionOffset, start.x, start.y);
+		writeExportVector(destination, exportLayout.sizeOffset, end.x - start.x, end.y - start.y);
+		writeExportValue(destination, exportLayout.depthOffset, depth);
+		writeGenerics(destination);
+		break;
+	case ExportType::PixelRectangle:
+		{
+			// start and end are snapped separately so that adjacent frames do not gain gaps or overlaps
+			// (values outside the range of std::int16_t are clamped to it)
+			auto snap = [](const T value) { return clampToInt16(std::floor(static_cast<double>(value) + 0.5)); };
+			const std::int16_t startX{ snap(start.x) };
+			const std::int16_t startY{ snap(start.y) };
+			writeExportVector(destination, exportLayout.positionOffset, startX, startY);
+			writeExportVector(destination, exportLayout.sizeOffset, clampToInt16(static_cast<double>(snap(end.x)) - startX), clampToInt16(static_cast<double>(snap(end.y)) - startY));
+			writeExportValue(destination, exportLayout.depthOffset, clampToInt16(static_cast<double>(m_frames[index].depth)));
+			writeGenerics(destination);
+		}
+		break;
+	}
+}
+
+template <class T>
+void DesignBase<T>::priv_insertIntoDrawOrder(const std::size_t index)
+{
+	// binary search for position (then a single move of the following indices, so insertion is still O(n))
+	const int depth{ m_frames[index].depth };
+	auto position{ std::lower_bound(m_drawOrder.begin(), m_drawOrder.end(), index, [&](const std::size_t lhs, const std::size_t rhs)
+	{
+		return (m_frames[lhs].depth == depth) ? (lhs < rhs) : (m_frames[lhs].depth < depth);
+	}) };
+	m_drawOrder.insert(position, index);
+}
+
+template <class T>
+void DesignBase<T>::priv_rebuildDrawOrder()
+{
+	// frames with the same depth are ordered by index (as std::stable_sort would, but without allocating)
+	const std::size_t framesSize{ m_frames.size() };
+	m_drawOrder.resize(framesSize);
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+		m_drawOrder[i] = i;
+	std::sort(m_drawOrder.begin(), m_drawOrder.end(), [&](const std::size_t lhs, const std::size_t rhs) { return (m_frames[lhs].depth == m_frames[rhs].depth) ? (lhs < rhs) : (m_frames[lhs].depth < m_frames[rhs].depth); });
+}
+
+template <class T>
+void DesignBase<T>::priv_removeFromDrawOrder(const std::size_t index)
+{
+	const int depth{ m_frames[index].depth };
+	auto position{ std::lower_bound(m_drawOrder.begin(), m_drawOrder.end(), index, [&](const std::size_t lhs, const std::size_t rhs)
+	{
+		return (m_frames[lhs].depth == depth) ? (lhs < rhs) : (m_frames[lhs].depth < depth);
+	}) };
+	if ((position != m_drawOrder.end()) && (*position == index))
+		m_drawOrder.erase(position);
+}
+
+template <class T>
+void DesignBase<T>::priv_moveInDrawOrder(std::size_t* const first, std::size_t* const last)
+{
+	// the frames are taken out together (leaving the others still sorted) and then each inserted at its new position
+	std::sort(first, last);
+	m_drawOrder.erase(std::remove_if(m_drawOrder.begin(), m_drawOrder.end(), [&](const std::size_t index) { return std::binary_search(first, last, index); }), m_drawOrder.end());
+	for (std::size_t* index{ first }; index != last; ++index)
+		priv_insertIntoDrawOrder(*index);
+}
+
+template <class T>
+void DesignBase<T>::priv_updateChildrenIndex() const
+{
+	const std::size_t framesSize{ m_frames.size() };
+	const std::size_t notVisited{ ~std::size_t{ 0u } };
+	ChildrenIndex& childrenIndex{ m_childrenIndex };
+	std::pmr::vector<std::size_t>& childrenStarts{ childrenIndex.childrenStarts };
+	std::pmr::vector<std::size_t>& children{ childrenIndex.children };
+	std::pmr::vector<std::size_t>& depthFirst{ childrenIndex.depthFirst };
+	std::pmr::vector<std::size_t>& positions{ childrenIndex.depthFirstPositions };
+	std::pmr::vector<std::size_t>& subtreeSizes{ childrenIndex.subtreeSizes };
+	std::pmr::vector<std::size_t>& stack{ childrenIndex.stack };
+
+	// count the children of each frame so that each frame's children can be placed directly after the previous frame's children
+	childrenStarts.assign(framesSize + 1u, 0u);
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	{
+		const int parentIndex{ m_frames[i].parentIndex };
+		if (priv_isValidFrameIndex(parentIndex) && (static_cast<std::size_t>(parentIndex) != i))
+			++childrenStarts[parentIndex + 1];
+	}
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+		childrenStarts[i + 1u] += childrenStarts[i];
+
+	// (positions is used temporarily for the next free place of each frame's children)
+	children.resize(childrenStarts[framesSize]);
+	positions.assign(childrenStarts.begin(), childrenStarts.end() - 1);
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	{
+		const int parentIndex{ m_frames[i].parentIndex };
+		if (priv_isValidFrameIndex(parentIndex) && (static_cast<std::size_t>(parentIndex) != i))
+			children[positions[parentIndex]++] = i;
+	}
+
+	// depth-first from each root in index order. frames in (or below) a loop of parents have no root so each loop is then started from one of its frames
+	// (while a frame is on the stack, its subtree size is used for the next of its children to visit)
+	depthFirst.clear();
+	positions.assign(framesSize, notVisited);
+	subtreeSizes.resize(framesSize);
+	stack.clear();
+	auto visit = [&](const std::size_t index)
+	{
+		positions[index] = depthFirst.size();
+		depthFirst.push_back(index);
+		subtreeSizes[index] = childrenStarts[index];
+		stack.push_back(index);
+	};
+	auto buildFrom = [&](const std::size_t root)
+	{
+		visit(root);
+		while (!stack.empty())
+		{
+			const std::size_t current{ stack.back() };
+			if (subtreeSizes[current] < childrenStarts[current + 1u])
+			{
+				const std::size_t child{ children[subtreeSizes[current]++] };
+				if (positions[child] == notVisited)
+					visit(child);
+			}
+			else
+			{
+				subtreeSizes[current] = depthFirst.size() - positions[current];
+				stack.pop_back();
+			}
+		}
+	};
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	{
+		if (!priv_isValidFrameIndex(m_frames[i].parentIndex))
+			buildFrom(i);
+	}
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	{
+		if (positions[i] != notVisited)
+			continue;
+
+		// walking up as many parents as there are frames must end inside the loop
+		std::size_t loopFrame{ i };
+		for (std::size_t step{ 0u }; step < framesSize; ++step)
+			loopFrame = static_cast<std::size_t>(m_frames[loopFrame].parentIndex);
+		buildFrom(loopFrame);
+	}
+
+	m_isChildrenIndexDirty = false;
+}
+
+template <class T>
+void DesignBase<T>::priv_removeFramesFrom(const std::size_t framesSize)
+{
+	if (framesSize >= m_frames.size())
+		return;
+
+	// frames are only removed from the end so the indices of the remaining frames do not change
+	m_frames.resize(framesSize);
+	m_frameStates.resize(framesSize);
+	priv_forEachVariantData([&](std::pmr::vector<Offsets>& offsets, std::pmr::vector<T>& genericValues, std::pmr::vector<std::uint8_t>& genericLayouts)
+	{
+		offsets.resize(framesSize);
+		genericValues.resize(framesSize * m_numOfGenerics);
+		genericLayouts.resize(framesSize * m_numOfGenerics);
+	});
+	m_layout.starts.resize(framesSize);
+	m_layout.ends.resize(framesSize);
+	m_layout.rangeStarts.resize(framesSize);
+	m_layout.rangeEnds.resize(framesSize);
+	m_layout.generics.resize(framesSize * m_layout.numOfGenerics); // (the number that the cached generics were resolved with)
+	m_layout.clipStarts.resize(framesSize);
+	m_layout.clipEnds.resize(framesSize);
+	m_layout.clipFrames.resize(framesSize);
+	m_snapshotChunks.resize(framesSize / framesPerSnapshotChunk); // a partly removed chunk no longer matches
+
+	auto isRemoved = [&](const std::size_t index) { return index >= framesSize; };
+	m_drawOrder.erase(std::remove_if(m_drawOrder.begin(), m_drawOrder.end(), isRemoved), m_drawOrder.end());
+	m_changedFrames.erase(std::remove_if(m_changedFrames.begin(), m_changedFrames.end(), isRemoved), m_changedFrames.end());
+
+	// frames whose parent was removed are now root frames
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	{
+		if (m_frames[i].parentIndex >= static_cast<int>(framesSize))
+			priv_invalidate(i);
+	}
+
+	m_isResolveOrderDirty = true;
+	m_isChildrenIndexDirty = true;
+	++m_structureVersion;
+}
+
+template <class T>
+DesignBase<T> DesignBase<T>::priv_getSnapshot() const
+{
+	// stored variants, the draw order and the change callback are not needed to resolve so they are not copied
+	DesignBase snapshot;
+	snapshot.m_frames = m_frames;
+	snapshot.m_offsets = m_offsets;
+	snapshot.m_genericValues = m_genericValues;
+	snapshot.m_genericLayouts = m_genericLayouts;
+	snapshot.m_numOfGenerics = m_numOfGenerics;
+	snapshot.m_layout = m_layout;
+	snapshot.m_frameStates = m_frameStates;
+	snapshot.m_resolveOrder = m_resolveOrder;
+	snapshot.m_isLayoutUpdated = m_isLayoutUpdated;
+	snapshot.m_isResolveOrderDirty = m_isResolveOrderDirty;
+	return snapshot;
+}
+
+template <class T>
+std::shared_ptr<const typename DesignBase<T>::ResolvedLayout> DesignBase<T>::priv_resolveSnapshot(DesignBase& snapshot, const std::size_t requestNumber, const std::atomic<std::size_t>& latestRequest)
+{
+	// a newer request (or a cancellation) has been made so this result is no longer wanted
+	if (latestRequest.load() != requestNumber)
+		return nullptr;
+
+	if (!snapshot.m_isLayoutUpdated)
+		snapshot.update();
+
+	if (latestRequest.load() != requestNumber)
+		return nullptr;
+
+	auto resolvedLayout{ std::make_shared<ResolvedLayout>() };
+	resolvedLayout->m_starts = std::move(snapshot.m_layout.starts);
+	resolvedLayout->m_ends = std::move(snapshot.m_layout.ends);
+	resolvedLayout->m_generics = std::move(snapshot.m_layout.generics);
+	resolvedLayout->m_numOfGenerics = snapshot.m_numOfGenerics;
+	resolvedLayout->m_requestNumber = requestNumber;
+	return resolvedLayout;
+}
+
+template <class T>
+void DesignBase<T>::priv_updateResolveOrder()
+{
+	// sort frames by their number of ancestors (and then by index so that frames keep index order within each level)
+	// std::sort is used instead of std::stable_sort as it does not allocate
+	const std::size_t framesSize{ m_frames.size() };
+	std::pmr::vector<std::size_t>& levels{ m_resolveLevels };
+	std::pmr::vector<std::size_t>& chain{ m_resolveChain };
+	levels.assign(framesSize, 0u);
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	{
+		if (levels[i] != 0u)
+			continue;
+
+		// walk up until a frame with a known level (or a root) is found. a chain longer than the number of frames must be a cycle and is treated as a root
+		chain.clear();
+		std::size_t current{ i };
+		std::size_t level{ 1u };
+		while (true)
+		{
+			chain.push_back(current);
+			const int parentIndex{ m_frames[current].parentIndex };
+			if (!priv_isValidFrameIndex(parentIndex) || (chain.size() > framesSize))
+				break;
+			current = static_cast<std::size_t>(parentIndex);
+			if (levels[current] != 0u)
+			{
+				level = levels[current] + 1u;
+				break;
+			}
+		}
+		for (auto c{ chain.rbegin() }; c != chain.rend(); ++c)
+		{
+			if (levels[*c] == 0u)
+				levels[*c] = level++;
+		}
+	}
+
+	m_resolveOrder.resize(framesSize);
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+		m_resolveOrder[i] = i;
+	std::sort(m_resolveOrder.begin(), m_resolveOrder.end(), [&](const std::size_t lhs, const std::size_t rhs) { return (levels[lhs] == levels[rhs]) ? (lhs < rhs) : (levels[lhs] < levels[rhs]); });
+
+	m_isResolveOrderDirty = false;
+}
+
+template <class T>
+Vector2Base<T> DesignBase<T>::priv_getLocal(const std::size_t index, const ValueType valueType) const
 {
 	return{ priv_getLocalComponent(index, valueType, ComponentType::X), priv_getLocalComponent(index, valueType, ComponentType::Y) };
 }
 
-float Design::priv_getLocalComponent(const std::size_t index, ValueType valueType, const ComponentType componentType, const std::size_t genericIndex) const
+template <class T>
+T DesignBase<T>::priv_getLocalComponent(const std::size_t index, ValueType valueType, const ComponentType componentType, const std::size_t genericIndex) const
 {
 	const Frame& f{ m_frames[index] };
 
-	const bool isX{ componentType == ComponentType::X };
-
-	if (f.isConsideredPoint && (valueType == ValueType::End))
+	if (priv_isPoint(index) && (valueType == ValueType::End))
 		valueType = ValueType::Start;
-	Property property{ 0.f, RelationType::Absolute, AnchorPoint::Start };
-	Property oppositeProperty{ 0.f, RelationType::Absolute, AnchorPoint::Start };
+	Property property{ T{}, RelationType::Absolute, AnchorPoint::Start };
+	Property oppositeProperty{ T{}, RelationType::Absolute, AnchorPoint::Start };
 	switch (valueType)
 	{
 	case ValueType::Start:
-		property = isX ? f.start.x : f.start.y;
-		oppositeProperty = isX ? f.end.x : f.end.y;
+		property = priv_getProperty(index, ValueType::Start, componentType);
+		oppositeProperty = priv_getProperty(index, ValueType::End, componentType);
 		break;
 	case ValueType::End:
-		property = isX ? f.end.x : f.end.y;
-		oppositeProperty = isX ? f.start.x : f.start.y;
+		property = priv_getProperty(index, ValueType::End, componentType);
+		oppositeProperty = priv_getProperty(index, ValueType::Start, componentType);
 		break;
 	case ValueType::Generic:
-		property = f.generics[genericIndex];
+		property = priv_getProperty(index, ValueType::Generic, ComponentType::X, genericIndex);
 		break;
 	}
 
 	return priv_unpackComponent(property, valueType, f.parentIndex, componentType, genericIndex, oppositeProperty);
 }
 
+template <class T>
+typename DesignBase<T>::Range DesignBase<T>::priv_getRange(const std::size_t index, const ComponentType componentType) const
+{
+	if (m_isLayoutUpdated)
+	{
+		const bool isX{ componentType == ComponentType::X };
+		return{ isX ? m_layout.rangeStarts[index].x : m_layout.rangeStarts[index].y, isX ? m_layout.rangeEnds[index].x : m_layout.rangeEnds[index].y };
+	}
+
+	const Frame& f{ m_frames[index] };
+	return{ priv_unpackComponent(priv_getProperty(index, ValueType::Start, componentType), ValueType::Start, f.parentIndex, componentType), priv_unpackComponent(priv_getProperty(index, ValueType::End, componentType), ValueType::End, f.parentIndex, componentType) };
+}
+
+template <class T>
+typename DesignBase<T>::Transform DesignBase<T>::priv_getPointTransform(const RelationType relationType, const AnchorPoint anchorPoint, const Range range)
+{
+	if ((relationType == RelationType::Absolute) && (anchorPoint != AnchorPoint::Size))
+		return{ static_cast<T>(1), T{} };
+
+	const T half{ static_cast<T>(0.5) };
+	const T scale{ (relationType == RelationType::Scale) ? (range.end - range.start) : static_cast<T>(1) };
+
+	switch (anchorPoint)
+	{
+	case AnchorPoint::Start:
+		return{ scale, range.start };
+	case AnchorPoint::Center:
+		return{ scale, (half * range.start) + (half * range.end) };
+	case AnchorPoint::End:
+		return{ scale, range.end };
+	case AnchorPoint::Size:
+		return{ scale, (relationType == RelationType::Relative) ? (range.end - range.start) : T{} };
+	default:
+		return{ scale, T{} };
+	}
+}
+
+template <class T>
+typename DesignBase<T>::Transform DesignBase<T>::priv_getInverseTransform(const Transform transform)
+{
+	if (transform.scale == T{})
+		return{ T{}, T{} };
+
+	const T inverseScale{ static_cast<T>(1) / transform.scale };
+	return{ inverseScale, -transform.offset * inverseScale };
+}
+
+template class DesignBase<float>;
+template class DesignBase<double>;
+template class DesignBase<Fixed32>;
+template class DesignBase<Fixed16>;
+
 } // namespace scaylay
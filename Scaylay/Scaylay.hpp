@@ -34,31 +34,47 @@
 
 #include <vector>
 #include <string>
+#include <functional>
+#include <future>
+#include <memory>
+#include <atomic>
+#include <memory_resource>
 
 namespace scaylay
 {
 
 // Scaylay Design v0.2.0
-class Design
+template <class T = float>
+class DesignBase
 {
 public:
+	using Vector2 = Vector2Base<T>;
+	using Property = PropertyBase<T>;
+	using Property2 = Property2Base<T>;
+	using Rectangle = RectangleBase<T>;
+
 	std::string getInfo(); // returns a human-readable string with some details of all frames
 
-	Design();
+	DesignBase();
+	explicit DesignBase(std::pmr::memory_resource* memoryResource); // all of the design's storage is allocated from the memory resource, which must outlive the design. copies use the default resource. objects given to the caller (patches, snapshots, layout programs and the results of resolveViewports) are allocated normally as they can outlive the design
+	template <class U>
+	explicit DesignBase(const DesignBase<U>& other); // converts all values to this scalar type
+
+	std::pmr::memory_resource* getMemoryResource() const;
 
 	std::size_t getCount() const { return m_frames.size(); }
 	std::size_t add(
-		Property2 startOffset = { { 0.f, RelationType::Scale }, { 0.f, RelationType::Scale } },
+		Property2 startOffset = { { T{}, RelationType::Scale }, { T{}, RelationType::Scale } },
 		bool isConsideredPoint = true,
 		int parentIndex = -1,
 		int groupId = 0,
 		int depth = 0,
-		Property2 endOffset = { { 0.f, RelationType::Scale }, { 0.f, RelationType::Scale } },
+		Property2 endOffset = { { T{}, RelationType::Scale }, { T{}, RelationType::Scale } },
 		std::vector<Property> generics = {});
-	std::size_t addAbsoluteRectangle(Vector2 position = { 0.f, 0.f }, Vector2 size = { 0.f, 0.f });
-	std::size_t addRelativeRectangle(std::size_t parentIndex, Vector2 position = { 0.f, 0.f }, Vector2 size = { 0.f, 0.f });
+	std::size_t addAbsoluteRectangle(Vector2 position = { T{}, T{} }, Vector2 size = { T{}, T{} });
+	std::size_t addRelativeRectangle(std::size_t parentIndex, Vector2 position = { T{}, T{} }, Vector2 size = { T{}, T{} });
 
-	std::size_t appendGeneric(float defaultGenericValue = 0.f, RelationType defaultRelationType = RelationType::Relative);
+	std::size_t appendGeneric(T defaultGenericValue = T{}, RelationType defaultRelationType = RelationType::Relative);
 	void resizeGenerics(std::size_t numberOfGenerics); // should trim all frames' generics to match and add extra ones (a default one, probably {0, relative}) if not enough.
 	void removeGeneric(std::size_t genericIndex);
 	void removeGenerics();
@@ -71,6 +87,25 @@ public:
 	void setStartOffset(std::size_t index, Vector2 offset);
 	void setEndOffset(std::size_t index, Vector2 offset);
 
+	// a transaction changes many frames with a single check of each frame and defers the rest (invalidation, draw order and structure changes) until it is committed (or destroyed) when each is done only once
+	// the draw order is not changed until the transaction is committed: a few frames with changed depths are then moved within it, otherwise it is sorted again
+	// the design should not be read or changed directly while a transaction has uncommitted changes
+	class Transaction;
+
+	// batch setters that change many frames in one transaction. indices can be a caller's vector or a range from the design (e.g. getDescendants or getDrawOrderAtDepth). invalid indices are skipped
+	void setStartOffsets(IndexRange indices, Vector2 offset);
+	void setStartOffsets(IndexRange indices, const std::vector<Vector2>& offsets); // one offset per index. nothing is changed if the sizes do not match
+	void setEndOffsets(IndexRange indices, Vector2 offset);
+	void setEndOffsets(IndexRange indices, const std::vector<Vector2>& offsets); // one offset per index. nothing is changed if the sizes do not match
+	void moveFrames(IndexRange indices, Vector2 amount); // adds to both start and end offsets
+	void setGroups(IndexRange indices, int groupId);
+	void setDepths(IndexRange indices, int depth);
+	void setGenerics(IndexRange indices, std::size_t genericIndex, T genericValue);
+	template <class Function>
+	void modifyFrames(IndexRange indices, Function function); // function(Transaction& transaction, std::size_t index) for each index
+	template <class Function>
+	void modifyFramesInGroup(int groupId, Function function); // function(Transaction& transaction, std::size_t index) for each frame in the group
+
 	void setStartAnchorPoint(std::size_t index, AnchorPoint anchorPoint);
 	void setStartOffsetXAnchorPoint(std::size_t index, AnchorPoint anchorPoint);
 	void setStartOffsetYAnchorPoint(std::size_t index, AnchorPoint anchorPoint);
@@ -85,7 +120,7 @@ public:
 	void setEndOffsetXRelationType(std::size_t index, RelationType relationType);
 	void setEndOffsetYRelationType(std::size_t index, RelationType relationType);
 
-	void setGeneric(std::size_t index, std::size_t genericIndex, float genericValue);
+	void setGeneric(std::size_t index, std::size_t genericIndex, T genericValue);
 	void setGenericRelationType(std::size_t index, std::size_t genericIndex, RelationType relationType);
 
 	int getParent(std::size_t index) const;
@@ -93,7 +128,7 @@ public:
 	int getDepth(std::size_t index) const;
 	Vector2 getStartOffset(std::size_t index) const;
 	Vector2 getEndOffset(std::size_t index) const;
-	float getGeneric(std::size_t index, std::size_t genericIndex) const;
+	T getGeneric(std::size_t index, std::size_t genericIndex) const;
 
 	AnchorPoint getStartOffsetXAnchorPoint(const std::size_t index) const;
 	AnchorPoint getStartOffsetYAnchorPoint(const std::size_t index) const;
@@ -108,10 +143,35 @@ public:
 	Vector2 getStartAbsolute(std::size_t index) const;
 	Vector2 getEndAbsolute(std::size_t index) const;
 	Vector2 getSizeAbsolute(std::size_t index) const;
-	float getGenericAbsolute(std::size_t index, std::size_t genericIndex) const;
+	T getGenericAbsolute(std::size_t index, std::size_t genericIndex) const;
 
 	Vector2 getPointInFrame(std::size_t index, Vector2 point, RelationType relationType, AnchorPoint anchorPoint) const; // relation and anchor applies to both x and y components equally here
 	Vector2 getPointInFrame(std::size_t index, Vector2 point, Vector2Relation relations, Vector2Anchor anchors) const;
+	std::vector<Vector2> getPointsInFrame(std::size_t index, const std::vector<Vector2>& points, RelationType relationType, AnchorPoint anchorPoint) const; // frame is resolved once for all points
+	std::vector<Vector2> getPointsInFrame(std::size_t index, const std::vector<Vector2>& points, Vector2Relation relations, Vector2Anchor anchors) const;
+	std::vector<Vector2> getPointsInFrame(std::size_t index, const std::vector<Vector2>& points, const std::vector<Vector2Relation>& relations, const std::vector<Vector2Anchor>& anchors) const; // one relation and one anchor per point
+	void getPointsInFrame(std::size_t index, const Vector2* points, Vector2* results, std::size_t numberOfPoints, Vector2Relation relations, Vector2Anchor anchors) const; // results may be the same array as points (in-place)
+
+	// inverse of getPointInFrame: converts an absolute point into a point inside the frame using the given relation and anchor (e.g. mouse position to frame co-ordinates)
+	// if the frame has no size in a scaled component, that component returns zero
+	Vector2 getLocalPointInFrame(std::size_t index, Vector2 absolutePoint, RelationType relationType, AnchorPoint anchorPoint) const;
+	Vector2 getLocalPointInFrame(std::size_t index, Vector2 absolutePoint, Vector2Relation relations, Vector2Anchor anchors) const;
+	std::vector<Vector2> getLocalPointsInFrame(std::size_t index, const std::vector<Vector2>& absolutePoints, RelationType relationType, AnchorPoint anchorPoint) const; // frame is resolved once for all points
+	std::vector<Vector2> getLocalPointsInFrame(std::size_t index, const std::vector<Vector2>& absolutePoints, Vector2Relation relations, Vector2Anchor anchors) const;
+	void getLocalPointsInFrame(std::size_t index, const Vector2* absolutePoints, Vector2* results, std::size_t numberOfPoints, Vector2Relation relations, Vector2Anchor anchors) const; // results may be the same array as absolutePoints (in-place)
+
+	// a frame that clips its children limits them (and all of their descendants) to its own rectangle (e.g. a scroll view). it is part of the frame's layout so it can differ between variants
+	// a frame's clip rectangle is its own rectangle intersected with the rectangles of all of its clipping ancestors. clip rectangles are calculated during update along with the absolute values
+	void setClipsChildren(std::size_t index, bool clipsChildren);
+	bool getClipsChildren(std::size_t index) const;
+	Rectangle getClipRectangle(std::size_t index) const;
+	int getClippingFrame(std::size_t index) const; // nearest ancestor that clips its children (-1 if none). its clip rectangle is the frame's scissor rectangle so scissor state only needs changing when this changes
+	bool isFullyClipped(std::size_t index) const; // its clip rectangle is empty: none of the frame is inside its clipping ancestors
+	std::vector<std::size_t> getFullyClippedFrames() const;
+	template <class Allocator>
+	void getFullyClippedFrames(std::vector<std::size_t, Allocator>& frames) const; // fills (after clearing) a caller's vector
+	template <class Allocator>
+	void getVisibleFrames(IndexRange indices, std::vector<std::size_t, Allocator>& frames) const; // the frames in indices (e.g. the draw order), in the same order, that are not fully clipped. fills (after clearing) a caller's vector
 
 	std::vector<std::size_t> getFramesInGroup(int groupId) const;
 	std::vector<std::size_t> getFramesInGroupRange(int groupIdMin, int groupIdMax, bool useInsideRange = true) const; // inside range is inclusive of limits (min/max); outside range is exclusve of limits.
@@ -122,6 +182,170 @@ public:
 	std::vector<std::size_t> getFramesToDepth(int depth, bool useBelow = true, bool sortAscending = true) const; // inclusive of specified depth regardless of useBelow value
 	std::vector<std::size_t> getFramesAtAllDepths(bool sortAscending = true) const;
 
+	// the same queries but filling a caller's vector (after clearing it) so that its memory can be reused and its allocator is used (e.g. a std::pmr::vector backed by a per-frame arena)
+	// no memory is allocated once the vector's capacity is large enough
+	template <class Allocator>
+	void getFramesInGroup(int groupId, std::vector<std::size_t, Allocator>& frames) const;
+	template <class Allocator>
+	void getFramesInGroupRange(int groupIdMin, int groupIdMax, bool useInsideRange, std::vector<std::size_t, Allocator>& frames) const;
+	template <class Allocator>
+	void getFramesInGroups(const std::vector<int>& groupIds, std::vector<std::size_t, Allocator>& frames) const;
+	template <class Allocator>
+	void getFramesAtDepth(int depth, std::vector<std::size_t, Allocator>& frames) const;
+	template <class Allocator>
+	void getFramesInDepthRange(int depthMin, int depthMax, bool useInsideRange, bool sortAscending, std::vector<std::size_t, Allocator>& frames) const;
+	template <class Allocator>
+	void getFramesToDepth(int depth, bool useBelow, bool sortAscending, std::vector<std::size_t, Allocator>& frames) const;
+	template <class Allocator>
+	void getFramesAtAllDepths(bool sortAscending, std::vector<std::size_t, Allocator>& frames) const;
+
+	// the draw order is all frames sorted by depth (ascending) and then by index. it is kept sorted as frames are added and depths are changed so reading it requires no sorting
+	const std::pmr::vector<std::size_t>& getDrawOrder() const;
+	IndexRange getDrawOrderAtDepth(int depth) const;
+	IndexRange getDrawOrderInDepthRange(int depthMin, int depthMax) const; // inclusive of limits (min/max)
+
+	// iterates from a frame's parent up to its root (without allocating)
+	class AncestorRange
+	{
+	public:
+		class Iterator
+		{
+		public:
+			std::size_t operator*() const { return static_cast<std::size_t>(m_index); }
+			Iterator& operator++()
+			{
+				const int parentIndex{ m_design->m_frames[m_index].parentIndex };
+				m_index = ((--m_stepsLeft == 0u) || !m_design->priv_isValidFrameIndex(parentIndex)) ? -1 : parentIndex;
+				return *this;
+			}
+			bool operator==(const Iterator& other) const { return m_index == other.m_index; }
+			bool operator!=(const Iterator& other) const { return m_index != other.m_index; }
+
+		private:
+			friend class AncestorRange;
+
+			const DesignBase* m_design;
+			int m_index; // -1 at the end
+			std::size_t m_stepsLeft; // limits the number of steps so that a loop of parents ends
+		};
+
+		Iterator begin() const { Iterator iterator; iterator.m_design = m_design; iterator.m_index = m_parentIndex; iterator.m_stepsLeft = m_design->getCount(); return iterator; }
+		Iterator end() const { Iterator iterator; iterator.m_design = m_design; iterator.m_index = -1; iterator.m_stepsLeft = 0u; return iterator; }
+		bool empty() const { return m_parentIndex == -1; }
+
+	private:
+		friend class DesignBase;
+
+		const DesignBase* m_design;
+		int m_parentIndex; // -1 if there are no ancestors
+	};
+
+	// children are indexed by parent so these do not search all frames. the whole index is rebuilt (not changed incrementally) after frames are added or parents are changed
+	// it is rebuilt by update or, if the structure has changed since, by the first of these queries. these queries are therefore only safe to call from multiple threads at once after update
+	// the returned ranges are only valid until the design's frames or parents are next changed
+	IndexRange getChildren(std::size_t index) const; // in index order
+	IndexRange getDescendants(std::size_t index) const; // depth-first: each child is followed by all of its own descendants
+	template <class Allocator>
+	void getDescendantsBreadthFirst(std::size_t index, std::vector<std::size_t, Allocator>& descendants) const; // all children, then all grandchildren, and so on. fills (after clearing) a caller's vector
+	AncestorRange getAncestors(std::size_t index) const;
+
+	// update resolves (and caches) the absolute values of the frames affected by any changes since the previous update. while nothing has been changed since, absolute values are read from that cache
+	// it returns the frames whose absolute start, end or any generic moved by more than epsilon. frames added since the previous update always count as changed
+	const std::pmr::vector<std::size_t>& update(T epsilon = T{});
+	bool isUpdated() const; // true if nothing has changed since the previous update
+	const std::pmr::vector<std::size_t>& getChangedFrames() const; // the frames that changed during the previous update (in index order)
+	bool getHasChanged(std::size_t index) const;
+	Vector2 getPreviousStartAbsolute(std::size_t index) const; // the absolute values from before the previous update (the same as the current ones if the frame did not change)
+	Vector2 getPreviousEndAbsolute(std::size_t index) const;
+	T getPreviousGenericAbsolute(std::size_t index, std::size_t genericIndex) const;
+	void setChangeCallback(std::function<void(std::size_t index)> changeCallback); // called for each changed frame during update (after all frames have been resolved). pass an empty function to remove
+
+	// writes resolved frames directly into a caller's (e.g. mapped vertex/instance) buffer as described by the export layout. returns the number of frames written (limited by buffer size)
+	// reads from the cache so should be called after update (if not updated, each frame is resolved individually)
+	// a list of indices can be used to choose which frames are written and in which order (e.g. from getFramesInGroup, getDrawOrder or getDrawOrderAtDepth)
+	// nothing is written (and zero is returned) if any value of the export layout does not fit within its stride
+	std::size_t exportFrames(void* buffer, std::size_t bufferSize, const ExportLayout& exportLayout) const;
+	std::size_t exportFrames(void* buffer, std::size_t bufferSize, const ExportLayout& exportLayout, IndexRange indices) const;
+
+	// variants are alternative sets of offsets, anchors, relations and generics (e.g. phone, tablet and desktop arrangements) kept side by side and switched between without rebuilding the design
+	// the design starts with a single (base) variant. setting offsets, anchors, relations and generics only affects the active variant; adding frames, parents, groups and depths affect all of them
+	// frames without a parent (e.g. a window frame) keep their current offsets when switching variants so the root size carries over
+	// the resolved layout of a variant is cached when switching away from it and is reused when switching back if nothing affecting it has changed. update then reports the frames that moved
+	std::size_t addVariant(Vector2 minimumRootSize); // the new variant is a copy of the active variant. returns its index
+	std::size_t getNumberOfVariants() const;
+	std::size_t getActiveVariant() const;
+	void setVariantMinimumRootSize(std::size_t variantIndex, Vector2 minimumRootSize);
+	Vector2 getVariantMinimumRootSize(std::size_t variantIndex) const;
+	void selectVariant(std::size_t variantIndex);
+	std::size_t selectVariantForRootSize(Vector2 rootSize); // selects the variant with the largest minimum root size (width first, then height) that fits. returns the selected variant
+	void removeVariants(); // keeps only the active variant, which becomes the base variant
+
+	// the absolute values of all frames from an asynchronous resolve. it is never changed after it is created so it can be read from any thread (e.g. a render thread) while the design is being changed
+	class ResolvedLayout
+	{
+	public:
+		std::size_t getCount() const { return m_starts.size(); }
+		std::size_t getNumberOfGenerics() const { return m_numOfGenerics; }
+		std::size_t getRequestNumber() const { return m_requestNumber; }
+		Vector2 getStartAbsolute(std::size_t index) const;
+		Vector2 getEndAbsolute(std::size_t index) const;
+		Vector2 getSizeAbsolute(std::size_t index) const;
+		T getGenericAbsolute(std::size_t index, std::size_t genericIndex) const;
+
+	private:
+		friend class DesignBase;
+
+		std::pmr::vector<Vector2> m_starts;
+		std::pmr::vector<Vector2> m_ends;
+		std::pmr::vector<T> m_generics; // m_numOfGenerics per frame, stored frame by frame
+		std::size_t m_numOfGenerics{ 0u };
+		std::size_t m_requestNumber{ 0u };
+	};
+
+	// resolves a snapshot of the design as it is now, allowing the design to be changed (e.g. for the next frame) while it is resolved elsewhere
+	// the executor is called once with a copyable task (taking no arguments) that it must run once on any thread, e.g. [](std::function<void()> task) { std::thread(task).detach(); } or a thread pool's submit
+	// only the most recent request is wanted: a request that is superseded by a newer one (or cancelled) before it finishes results in a null pointer
+	// an exception thrown while resolving is stored in the future (and rethrown by its get)
+	// the snapshot includes the cached layout so only the frames changed since the previous update are resolved
+	template <class Executor>
+	std::future<std::shared_ptr<const ResolvedLayout>> resolveAsync(Executor executor);
+	void cancelResolveAsync(); // any unfinished requests result in a null pointer
+
+	// resolves the design for many sizes at once (e.g. thumbnails, previews or a sweep of screen resolutions) in a single pass over the frames, without changing the frames or the cached layout
+	// it is not const as it may rebuild the resolve order (a cache of the order in which frames are resolved, rebuilt when next needed after parents are changed)
+	// each viewport replaces the rectangle of the root frame (usually a frame without a parent, such as a window). results are resized to one per viewport (with no frames if the root index is invalid) and their memory is reused
+	// each frame is decoded only once and then applied to all viewports together. floating-point results can differ from those of update in the last bits
+	void resolveViewports(std::size_t rootIndex, const std::vector<Rectangle>& viewports, std::vector<ResolvedLayout>& results);
+
+	// a layout program is the design compiled into one instruction per frame (parents first), each holding the factors of its components for any parent range (see priv_getLinearComponent)
+	// running it resolves every frame in a single straight-line pass without decoding relations or anchors. it is independent of the design so it must be compiled again after the design is changed
+	// root frames can be given new rectangles without compiling again (e.g. when a window is resized). floating-point results can differ from those of update in the last bits
+	class LayoutProgram;
+
+	void compileLayout(LayoutProgram& program); // the program's memory is reused
+
+	// animation tracks change an offset component (or a generic) of a frame over time by interpolating between keyframes. tracks affect the active variant
+	// animate evaluates all tracks together and only sets (and invalidates) values that actually change so only the animated frames (and their children) are resolved again by update
+	std::size_t addAnimationTrack(std::size_t index, AnimationTarget target, std::size_t genericIndex = 0u); // returns the track index
+	void addKeyframe(std::size_t trackIndex, T time, T value, Easing easing = Easing::Linear); // easing is used on the approach to this keyframe. keyframes can be added in any order
+	std::size_t getNumberOfAnimationTracks() const;
+	void removeAnimationTracks();
+	void animate(T time); // before the first keyframe, a track has the first keyframe's value; after the last keyframe, it has the last keyframe's value
+
+	// a patch holds only the frames that differ between two designs (e.g. a design and a reloaded version of it) so that applying it changes (and invalidates) only those frames
+	// only the active variants are compared and patched. frames added by a patch are added to all variants
+	class Patch;
+
+	Patch getPatch(const DesignBase& target) const; // the changes that make this design match the target
+	void applyPatch(const Patch& patch); // frames (at the end) are removed if the patch's design has fewer frames. if the number of generics changes, all frames must be resolved again
+
+	// a snapshot holds the frames (of the active variant) in chunks that are shared with the design and with other snapshots, so taking one only copies the chunks changed since the previous one (e.g. for undo and redo)
+	// restoring one only compares the chunks that are not shared with it and only changes (and invalidates) the frames that differ, so the cached layout of all other frames is kept
+	class Snapshot;
+
+	Snapshot takeSnapshot();
+	void restoreSnapshot(const Snapshot& snapshot); // frames (at the end) are removed if the snapshot has fewer frames. if the number of generics changes, all frames must be resolved again
+
 
 
 
@@ -130,21 +354,167 @@ public:
 
 
 private:
+	template <class U>
+	friend class DesignBase;
+
 	struct Frame
 	{
-		bool isConsideredPoint;
 		int parentIndex;
 		int groupId;
 		int depth; // z-order
-		Property2 start;
-		Property2 end;
-		std::vector<Property> generics;
+	};
+	struct Offsets
+	{
+		Vector2 start;
+		Vector2 end;
+		std::uint32_t layout; // relation and anchor of all four components (4 bits each: see priv_getLayoutShift) and the point flag
 	};
 
-	std::vector<Frame> m_frames;
+	std::pmr::vector<Frame> m_frames; // its memory resource is the design's memory resource
+	std::pmr::vector<Offsets> m_offsets; // one per frame
+	std::pmr::vector<T> m_genericValues; // m_numOfGenerics per frame, stored frame by frame
+	std::pmr::vector<std::uint8_t> m_genericLayouts; // relation and anchor of each generic value (4 bits)
 
 	std::size_t m_numOfGenerics;
 
+	static constexpr std::uint32_t layoutRelationMask{ 0x3u };
+	static constexpr std::uint32_t layoutAnchorMask{ 0xCu };
+	static constexpr std::uint32_t layoutPointFlag{ 1u << 16u };
+	static constexpr std::uint32_t layoutClipFlag{ 1u << 17u };
+
+	struct Layout // resolved (absolute) values of all frames
+	{
+		std::pmr::vector<Vector2> starts;
+		std::pmr::vector<Vector2> ends;
+		std::pmr::vector<Vector2> rangeStarts; // the range that each frame provides to its children (see priv_getRange)
+		std::pmr::vector<Vector2> rangeEnds;
+		std::pmr::vector<T> generics; // numOfGenerics per frame, stored frame by frame
+		std::pmr::vector<Vector2> clipStarts; // clip rectangle of each frame (see getClipRectangle)
+		std::pmr::vector<Vector2> clipEnds;
+		std::pmr::vector<int> clipFrames; // nearest of each frame and its ancestors that clips its children (-1 if none). its clip rectangle is the one given to the frame's children
+
+		std::size_t numOfGenerics; // m_numOfGenerics when the layout was last updated (all frames must be resolved again if it is different)
+
+		explicit Layout(std::pmr::memory_resource* const memoryResource) : starts(memoryResource), ends(memoryResource), rangeStarts(memoryResource), rangeEnds(memoryResource), generics(memoryResource), clipStarts(memoryResource), clipEnds(memoryResource), clipFrames(memoryResource), numOfGenerics{ 0u } {}
+	};
+
+	Layout m_layout;
+	Layout m_previousLayout; // only the frames that changed during the previous update are kept here
+	std::pmr::vector<std::uint8_t> m_frameStates; // one per frame. see frameState constants
+	std::pmr::vector<std::size_t> m_resolveOrder; // all frame indices, with parents before their children
+	std::pmr::vector<std::size_t> m_resolveLevels; // used while rebuilding the resolve order: one per frame (its number of ancestors plus one)
+	std::pmr::vector<std::size_t> m_resolveChain; // used while rebuilding the resolve order
+	std::pmr::vector<std::size_t> m_changedFrames;
+	std::function<void(std::size_t)> m_changeCallback;
+	bool m_isLayoutUpdated;
+	bool m_isResolveOrderDirty;
+
+	static constexpr std::uint8_t frameStateDirty{ 1u }; // frame's own values have changed since the previous update
+	static constexpr std::uint8_t frameStateChanged{ 2u }; // frame's absolute values changed during the previous update
+	static constexpr std::uint8_t frameStateRangeChanged{ 4u }; // used during update: children must be resolved again
+	static constexpr std::uint8_t frameStateCompare{ 8u }; // previous values were stored when switching variants so the frame must be compared during update even if not resolved
+	static constexpr std::uint8_t frameStateClipChanged{ 16u }; // used during update: the clip rectangle given to the children changed
+
+	struct Variant
+	{
+		Vector2 minimumRootSize;
+		std::pmr::vector<Offsets> offsets; // empty while this is the active variant (its values are in m_offsets)
+		std::pmr::vector<T> genericValues;
+		std::pmr::vector<std::uint8_t> genericLayouts;
+		Layout layout; // cached from when this variant was last active
+		bool isLayoutValid;
+		std::size_t structureVersion; // value of m_structureVersion when layout was cached
+
+		explicit Variant(std::pmr::memory_resource* const memoryResource) : minimumRootSize{ T{}, T{} }, offsets(memoryResource), genericValues(memoryResource), genericLayouts(memoryResource), layout(memoryResource), isLayoutValid{ false }, structureVersion{ 0u } {}
+	};
+
+	std::pmr::vector<Variant> m_variants; // always at least one (the base variant)
+	std::size_t m_activeVariant;
+	std::size_t m_structureVersion; // increased by changes that affect all variants (e.g. adding frames or changing parents)
+
+	std::pmr::vector<std::size_t> m_drawOrder; // all frame indices sorted by depth and then index
+
+	struct ResolveRequests // number of the most recent asynchronous resolve request. shared with the requests' tasks (so the design can be destroyed before they run) but not with copies of the design
+	{
+		std::shared_ptr<std::atomic<std::size_t>> latest{ std::make_shared<std::atomic<std::size_t>>(0u) };
+
+		ResolveRequests() = default;
+		ResolveRequests(const ResolveRequests&) : ResolveRequests() {}
+		ResolveRequests& operator=(const ResolveRequests&) { return *this; }
+	};
+
+	ResolveRequests m_resolveRequests;
+
+	struct Keyframe
+	{
+		T time;
+		T value;
+		Easing easing;
+	};
+	struct AnimationTrack
+	{
+		std::size_t index;
+		AnimationTarget target;
+		std::size_t genericIndex;
+		std::pmr::vector<Keyframe> keyframes; // sorted by time
+		std::size_t nextKeyframe; // first keyframe after the previously animated time. searching starts here since time usually moves forwards in small steps
+	};
+	struct AnimationValues // filled (one per track) during animate so that interpolation is a single pass over contiguous values
+	{
+		std::pmr::vector<T> starts;
+		std::pmr::vector<T> differences;
+		std::pmr::vector<T> progresses; // already eased
+		std::pmr::vector<T> results;
+
+		explicit AnimationValues(std::pmr::memory_resource* const memoryResource) : starts(memoryResource), differences(memoryResource), progresses(memoryResource), results(memoryResource) {}
+	};
+
+	std::pmr::vector<AnimationTrack> m_animationTracks;
+	AnimationValues m_animationValues;
+
+	struct ChildrenIndex // compressed (CSR) children of each frame and a depth-first order of all frames, in which every subtree is contiguous
+	{
+		std::pmr::vector<std::size_t> childrenStarts; // one per frame plus one. children of frame i are from children[childrenStarts[i]] to (but not including) children[childrenStarts[i + 1]]
+		std::pmr::vector<std::size_t> children;
+		std::pmr::vector<std::size_t> depthFirst; // all frames with each frame followed by its descendants
+		std::pmr::vector<std::size_t> depthFirstPositions; // one per frame: position in depthFirst
+		std::pmr::vector<std::size_t> subtreeSizes; // one per frame: number of frames in its subtree (including itself)
+		std::pmr::vector<std::size_t> stack; // used while building
+
+		explicit ChildrenIndex(std::pmr::memory_resource* const memoryResource) : childrenStarts(memoryResource), children(memoryResource), depthFirst(memoryResource), depthFirstPositions(memoryResource), subtreeSizes(memoryResource), stack(memoryResource) {}
+	};
+
+	mutable ChildrenIndex m_childrenIndex; // rebuilt by update or by (const) queries when needed
+	mutable bool m_isChildrenIndexDirty;
+
+	struct ViewportValues // used by resolveViewports. each value is stored once per viewport (together) so that all viewports can be processed in one loop
+	{
+		std::pmr::vector<T> rangeStartsX; // per frame
+		std::pmr::vector<T> rangeStartsY;
+		std::pmr::vector<T> rangeEndsX;
+		std::pmr::vector<T> rangeEndsY;
+		std::pmr::vector<T> generics; // per generic of each frame
+		std::pmr::vector<T> startsX; // current frame only
+		std::pmr::vector<T> startsY;
+		std::pmr::vector<T> endsX;
+		std::pmr::vector<T> endsY;
+
+		explicit ViewportValues(std::pmr::memory_resource* const memoryResource) : rangeStartsX(memoryResource), rangeStartsY(memoryResource), rangeEndsX(memoryResource), rangeEndsY(memoryResource), generics(memoryResource), startsX(memoryResource), startsY(memoryResource), endsX(memoryResource), endsY(memoryResource) {}
+	};
+
+	ViewportValues m_viewportValues;
+
+	struct SnapshotChunk // values of (up to) framesPerSnapshotChunk consecutive frames. never changed once created so that it can be shared
+	{
+		std::vector<Frame> frames;
+		std::vector<Offsets> offsets;
+		std::vector<T> genericValues; // m_numOfGenerics per frame, stored frame by frame
+		std::vector<std::uint8_t> genericLayouts;
+	};
+
+	static constexpr std::size_t framesPerSnapshotChunk{ 64u };
+	std::pmr::vector<std::shared_ptr<const SnapshotChunk>> m_snapshotChunks; // chunks (shared with snapshots) that still match the frames. null where a frame in the chunk has changed since
+
 	enum class ComponentType
 	{
 		X,
@@ -157,10 +527,65 @@ private:
 		Generic,
 	};
 
-	float priv_unpackComponent(const Property property, const ValueType valueType, const int parentIndex = -1, const ComponentType componentType = ComponentType::X, const std::size_t genericIndex = 0u, const Property oppositeProperty = Property{}) const;
+	struct Range
+	{
+		T start;
+		T end;
+	};
+	struct Transform // result = (value * scale) + offset
+	{
+		T scale;
+		T offset;
+	};
+	struct LinearComponent // result = (parentStartScale * parentRange.start) + (parentEndScale * parentRange.end) + offset
+	{
+		T parentStartScale;
+		T parentEndScale;
+		T offset;
+	};
+
+	T priv_unpackComponent(const Property property, const ValueType valueType, const int parentIndex = -1, const ComponentType componentType = ComponentType::X, const std::size_t genericIndex = 0u, const Property oppositeProperty = Property{}) const;
+	static T priv_resolveComponent(Property property, const ValueType valueType, const Range parentRange, Property oppositeProperty); // start or end component with an already resolved parent range
+	static LinearComponent priv_getLinearComponent(const Property property, const ValueType valueType, const Property oppositeProperty); // priv_resolveComponent for any parent range
+	void priv_resolveFrame(const std::size_t index, Layout& layout) const; // parent must already be resolved in the layout
+	bool priv_resolveClip(const std::size_t index); // frame must already be resolved. returns true if the clip rectangle given to its children changed
+	void priv_updateResolveOrder();
+	void priv_invalidate(const std::size_t index);
+	void priv_invalidateAll();
+	void priv_addFrame(); // adds a frame of zeroes (e.g. for its values to then be set by a patch)
+	void priv_setFrameValues(const std::size_t index, const Frame& frame, const Offsets& offsets, const T* const genericValues, const std::uint8_t* const genericLayouts); // m_numOfGenerics generics. only invalidates the frame if its layout changes
+	void priv_invalidateSnapshotChunk(const std::size_t index);
+	static bool priv_isDifferent(const T a, const T b, const T epsilon);
+	void priv_exportFrame(unsigned char* destination, const std::size_t index, const ExportLayout& exportLayout) const;
+	bool priv_isValidExportLayout(const ExportLayout& exportLayout) const; // every value written fits within the stride
+	template <class Function>
+	void priv_forEachVariantData(Function function); // function(offsets, genericValues, genericLayouts) for the active and all stored variants
+	void priv_insertIntoDrawOrder(const std::size_t index);
+	void priv_rebuildDrawOrder();
+	void priv_removeFromDrawOrder(const std::size_t index);
+	void priv_moveInDrawOrder(std::size_t* const first, std::size_t* const last); // frames whose depths have changed (since the draw order was sorted). sorts the indices
+	template <class Function>
+	void priv_forEachInDrawOrder(const bool ascending, Function function) const; // descending reverses the depths but frames with the same depth stay in index order
+	void priv_updateChildrenIndex() const;
+	void priv_removeFramesFrom(const std::size_t framesSize); // removes all frames from this index onwards
+	DesignBase priv_getSnapshot() const; // copy of only what is needed to update (frames, active variant's values and the cached layout)
+	static std::shared_ptr<const ResolvedLayout> priv_resolveSnapshot(DesignBase& snapshot, const std::size_t requestNumber, const std::atomic<std::size_t>& latestRequest);
 
 	Vector2 priv_getLocal(const std::size_t index, const ValueType valueType) const;
-	float priv_getLocalComponent(const std::size_t index, const ValueType valueType, const ComponentType componentType = ComponentType::X, const std::size_t genericIndex = 0u) const;
+	T priv_getLocalComponent(const std::size_t index, const ValueType valueType, const ComponentType componentType = ComponentType::X, const std::size_t genericIndex = 0u) const;
+
+	Range priv_getRange(const std::size_t index, const ComponentType componentType) const; // the range that the frame provides to anything positioned inside it
+	static Transform priv_getPointTransform(const RelationType relationType, const AnchorPoint anchorPoint, const Range range); // matches priv_unpackComponent for a (start) point inside a frame of the given range
+	static Transform priv_getInverseTransform(const Transform transform);
+
+	static unsigned int priv_getLayoutShift(const ValueType valueType, const ComponentType componentType);
+	static std::uint32_t priv_packLayout(const RelationType relationType, const AnchorPoint anchorPoint);
+	static Property priv_unpackLayout(const T value, const std::uint32_t layout);
+	Property priv_getProperty(const std::size_t index, const ValueType valueType, const ComponentType componentType = ComponentType::X, const std::size_t genericIndex = 0u) const;
+	void priv_setRelationType(const std::size_t index, const ValueType valueType, const ComponentType componentType, const RelationType relationType, const std::size_t genericIndex = 0u);
+	void priv_setAnchorPoint(const std::size_t index, const ValueType valueType, const ComponentType componentType, const AnchorPoint anchorPoint);
+	bool priv_isPoint(const std::size_t index) const;
+	bool priv_isClippingChildren(const std::size_t index) const;
 
 	bool priv_isValidFrameIndex(const int index) const;
 	bool priv_isValidFrameIndex(const std::size_t index) const;
@@ -174,8 +599,220 @@ private:
 
 
 
+template <class T>
+class DesignBase<T>::Patch
+{
+public:
+	std::size_t getNumberOfChangedFrames() const { return m_changes.size(); }
+	bool isEmpty() const { return m_changes.empty() && !m_isNumberOfFramesChanged && !m_isNumberOfGenericsChanged; }
+
+private:
+	friend class DesignBase<T>;
+
+	struct Change
+	{
+		std::size_t index;
+		Frame frame;
+		Offsets offsets;
+	};
+
+	std::vector<Change> m_changes; // in index order
+	std::vector<T> m_genericValues; // m_numOfGenerics per change
+	std::vector<std::uint8_t> m_genericLayouts;
+	std::size_t m_numberOfFrames{ 0u };
+	std::size_t m_numOfGenerics{ 0u };
+	bool m_isNumberOfFramesChanged{ false };
+	bool m_isNumberOfGenericsChanged{ false };
+};
+
+
+
+
+
+
+
+template <class T>
+class DesignBase<T>::Snapshot
+{
+public:
+	std::size_t getCount() const { return m_numberOfFrames; }
+	std::size_t getNumberOfGenerics() const { return m_numOfGenerics; }
+
+private:
+	friend class DesignBase<T>;
+
+	std::vector<std::shared_ptr<const SnapshotChunk>> m_chunks;
+	std::size_t m_numberOfFrames{ 0u };
+	std::size_t m_numOfGenerics{ 0u };
+};
+
+
+
+
+
+
+
+template <class T>
+class DesignBase<T>::LayoutProgram
+{
+public:
+	std::size_t getCount() const { return m_starts.size(); }
+	std::size_t getNumberOfGenerics() const { return m_numOfGenerics; }
+	void setRootRectangle(std::size_t index, Rectangle rectangle); // ignored if the frame has a parent
+	void run();
+	Vector2 getStartAbsolute(std::size_t index) const;
+	Vector2 getEndAbsolute(std::size_t index) const;
+	Vector2 getSizeAbsolute(std::size_t index) const;
+	T getGenericAbsolute(std::size_t index, std::size_t genericIndex) const;
+
+private:
+	friend class DesignBase<T>;
+
+	struct Instruction
+	{
+		std::size_t index;
+		std::size_t parentIndex; // root frames read the zero range after the last frame
+		LinearComponent startX;
+		LinearComponent startY;
+		LinearComponent endX;
+		LinearComponent endY;
+		LinearComponent rangeStartX;
+		LinearComponent rangeStartY;
+		LinearComponent rangeEndX;
+		LinearComponent rangeEndY;
+		bool isPoint;
+	};
+
+	std::vector<Instruction> m_instructions; // parents before their children
+	std::vector<Transform> m_genericTransforms; // m_numOfGenerics per instruction: result = (parent generic * scale) + offset
+	std::vector<std::size_t> m_instructionIndices; // one per frame: position of its instruction
+	std::size_t m_numOfGenerics{ 0u };
+
+	std::vector<Vector2> m_starts;
+	std::vector<Vector2> m_ends;
+	std::vector<Vector2> m_rangeStarts; // one per frame plus the zero range
+	std::vector<Vector2> m_rangeEnds;
+	std::vector<T> m_generics; // m_numOfGenerics per frame plus zeroes, stored frame by frame
+
+	static T priv_apply(const LinearComponent component, const T parentStart, const T parentEnd) { return (component.parentStartScale * parentStart) + (component.parentEndScale * parentEnd) + component.offset; }
+};
+
+
+
+
+
+
+
+
+template <class T>
+class DesignBase<T>::Transaction
+{
+public:
+	explicit Transaction(DesignBase& design) : m_design(design), m_depthChangedFrames{}, m_numberOfDepthChanges{ 0u }, m_isChanged{ false }, m_isDrawOrderChanged{ false }, m_isStructureChanged{ false } {}
+	~Transaction() { commit(); }
+	Transaction(const Transaction&) = delete;
+	Transaction& operator=(const Transaction&) = delete;
+
+	void setParent(std::size_t index, int parentIndex);
+	void setGroup(std::size_t index, int groupId);
+	void setDepth(std::size_t index, int depth);
+	void setStartOffset(std::size_t index, Vector2 offset);
+	void setEndOffset(std::size_t index, Vector2 offset);
+	void moveFrame(std::size_t index, Vector2 amount); // adds to both start and end offsets
+	void setGeneric(std::size_t index, std::size_t genericIndex, T genericValue);
+
+	void commit();
+
+private:
+	static constexpr std::size_t maxDrawOrderMoves{ 32u }; // each move shifts part of the draw order so a single sort is quicker after many
+
+	DesignBase& m_design;
+	std::size_t m_depthChangedFrames[maxDrawOrderMoves]; // moved within the draw order when committed
+	std::size_t m_numberOfDepthChanges;
+	bool m_isChanged;
+	bool m_isDrawOrderChanged; // too many depth changes to move: the draw order is sorted again when committed
+	bool m_isStructureChanged;
+
+	void priv_invalidate(const std::size_t index);
+};
+
+
+
 // PUBLIC
-inline void Design::setParent(const std::size_t index, int parentIndex)
+template <class T>
+template <class U>
+inline DesignBase<T>::DesignBase(const DesignBase<U>& other)
+	: m_frames(other.m_frames.size())
+	, m_offsets(other.m_offsets.size())
+	, m_genericValues(other.m_genericValues.size())
+	, m_genericLayouts(other.m_genericLayouts)
+	, m_numOfGenerics{ other.m_numOfGenerics }
+	, m_layout(std::pmr::get_default_resource())
+	, m_previousLayout(std::pmr::get_default_resource())
+	, m_frameStates(other.m_frames.size(), frameStateDirty)
+	, m_resolveOrder()
+	, m_resolveLevels(std::pmr::get_default_resource())
+	, m_resolveChain(std::pmr::get_default_resource())
+	, m_changedFrames()
+	, m_changeCallback()
+	, m_isLayoutUpdated{ false }
+	, m_isResolveOrderDirty{ true }
+	, m_variants()
+	, m_activeVariant{ other.m_activeVariant }
+	, m_structureVersion{ 0u }
+	, m_drawOrder(other.m_drawOrder)
+	, m_resolveRequests()
+	, m_animationTracks(other.m_animationTracks.size())
+	, m_animationValues(std::pmr::get_default_resource())
+	, m_childrenIndex(std::pmr::get_default_resource())
+	, m_isChildrenIndexDirty{ true }
+	, m_viewportValues(std::pmr::get_default_resource())
+	, m_snapshotChunks(std::pmr::get_default_resource())
+{
+	const std::size_t framesSize{ m_frames.size() };
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+		m_frames[i] = { other.m_frames[i].parentIndex, other.m_frames[i].groupId, other.m_frames[i].depth };
+
+	auto convertOffsets = [](std::pmr::vector<Offsets>& offsets, const auto& otherOffsets)
+	{
+		offsets.resize(otherOffsets.size());
+		for (std::size_t i{ 0u }; i < offsets.size(); ++i)
+			offsets[i] = { vector2Cast<T>(otherOffsets[i].start), vector2Cast<T>(otherOffsets[i].end), otherOffsets[i].layout };
+	};
+	auto convertValues = [](std::pmr::vector<T>& values, const auto& otherValues)
+	{
+		values.resize(otherValues.size());
+		for (std::size_t i{ 0u }; i < values.size(); ++i)
+			values[i] = static_cast<T>(otherValues[i]);
+	};
+
+	convertOffsets(m_offsets, other.m_offsets);
+	convertValues(m_genericValues, other.m_genericValues);
+
+	// cached layouts are not converted
+	const std::size_t variantsSize{ other.m_variants.size() };
+	for (std::size_t v{ 0u }; v < variantsSize; ++v)
+	{
+		Variant& variant{ m_variants.emplace_back(std::pmr::get_default_resource()) };
+		variant.minimumRootSize = vector2Cast<T>(other.m_variants[v].minimumRootSize);
+		convertOffsets(variant.offsets, other.m_variants[v].offsets);
+		convertValues(variant.genericValues, other.m_variants[v].genericValues);
+		variant.genericLayouts = other.m_variants[v].genericLayouts;
+	}
+
+	const std::size_t animationTracksSize{ m_animationTracks.size() };
+	for (std::size_t t{ 0u }; t < animationTracksSize; ++t)
+	{
+		const auto& otherTrack{ other.m_animationTracks[t] };
+		AnimationTrack& track{ m_animationTracks[t] };
+		track = { otherTrack.index, otherTrack.target, otherTrack.genericIndex, std::pmr::vector<Keyframe>(otherTrack.keyframes.size()), otherTrack.nextKeyframe };
+		for (std::size_t k{ 0u }; k < track.keyframes.size(); ++k)
+			track.keyframes[k] = { static_cast<T>(otherTrack.keyframes[k].time), static_cast<T>(otherTrack.keyframes[k].value), otherTrack.keyframes[k].easing };
+	}
+}
+
+template <class T>
+inline void DesignBase<T>::setParent(const std::size_t index, int parentIndex)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
@@ -183,153 +820,297 @@ inline void Design::setParent(const std::size_t index, int parentIndex)
 	if (parentIndex < -1)
 		parentIndex = -1;
 	m_frames[index].parentIndex = parentIndex;
+	m_isResolveOrderDirty = true;
+	m_isChildrenIndexDirty = true;
+	++m_structureVersion;
+	priv_invalidate(index);
 }
 
-inline void Design::setGroup(const std::size_t index, const int groupId)
+template <class T>
+inline void DesignBase<T>::setGroup(const std::size_t index, const int groupId)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
 	m_frames[index].groupId = groupId;
+	priv_invalidateSnapshotChunk(index);
 }
 
-inline void Design::setDepth(const std::size_t index, const int depth)
+template <class T>
+inline void DesignBase<T>::setDepth(const std::size_t index, const int depth)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
+	if (m_frames[index].depth == depth)
+		return;
+
+	priv_removeFromDrawOrder(index);
 	m_frames[index].depth = depth;
+	priv_insertIntoDrawOrder(index);
+	priv_invalidateSnapshotChunk(index);
 }
 
-inline void Design::setStartOffset(const std::size_t index, const Vector2 startOffset)
+template <class T>
+inline void DesignBase<T>::setStartOffset(const std::size_t index, const Vector2 startOffset)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].start = startOffset;
+	m_offsets[index].start = startOffset;
+	priv_invalidate(index);
+}
+
+template <class T>
+inline void DesignBase<T>::setStartOffsets(const IndexRange indices, const Vector2 offset)
+{
+	Transaction transaction{ *this };
+	for (const std::size_t index : indices)
+		transaction.setStartOffset(index, offset);
+}
+
+template <class T>
+inline void DesignBase<T>::setStartOffsets(const IndexRange indices, const std::vector<Vector2>& offsets)
+{
+	const std::size_t indicesSize{ indices.size() };
+	if (offsets.size() != indicesSize)
+		return;
+
+	Transaction transaction{ *this };
+	for (std::size_t i{ 0u }; i < indicesSize; ++i)
+		transaction.setStartOffset(indices[i], offsets[i]);
+}
+
+template <class T>
+inline void DesignBase<T>::setEndOffsets(const IndexRange indices, const Vector2 offset)
+{
+	Transaction transaction{ *this };
+	for (const std::size_t index : indices)
+		transaction.setEndOffset(index, offset);
+}
+
+template <class T>
+inline void DesignBase<T>::setEndOffsets(const IndexRange indices, const std::vector<Vector2>& offsets)
+{
+	const std::size_t indicesSize{ indices.size() };
+	if (offsets.size() != indicesSize)
+		return;
+
+	Transaction transaction{ *this };
+	for (std::size_t i{ 0u }; i < indicesSize; ++i)
+		transaction.setEndOffset(indices[i], offsets[i]);
+}
+
+template <class T>
+inline void DesignBase<T>::moveFrames(const IndexRange indices, const Vector2 amount)
+{
+	Transaction transaction{ *this };
+	for (const std::size_t index : indices)
+		transaction.moveFrame(index, amount);
+}
+
+template <class T>
+inline void DesignBase<T>::setGroups(const IndexRange indices, const int groupId)
+{
+	Transaction transaction{ *this };
+	for (const std::size_t index : indices)
+		transaction.setGroup(index, groupId);
+}
+
+template <class T>
+inline void DesignBase<T>::setDepths(const IndexRange indices, const int depth)
+{
+	Transaction transaction{ *this };
+	for (const std::size_t index : indices)
+		transaction.setDepth(index, depth);
+}
+
+template <class T>
+inline void DesignBase<T>::setGenerics(const IndexRange indices, const std::size_t genericIndex, const T genericValue)
+{
+	Transaction transaction{ *this };
+	for (const std::size_t index : indices)
+		transaction.setGeneric(index, genericIndex, genericValue);
+}
+
+template <class T>
+template <class Function>
+inline void DesignBase<T>::modifyFrames(const IndexRange indices, Function function)
+{
+	Transaction transaction{ *this };
+	for (const std::size_t index : indices)
+		function(transaction, index);
+}
+
+template <class T>
+template <class Function>
+inline void DesignBase<T>::modifyFramesInGroup(const int groupId, Function function)
+{
+	Transaction transaction{ *this };
+	const std::size_t framesSize{ m_frames.size() };
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	{
+		if (m_frames[i].groupId == groupId)
+			function(transaction, i);
+	}
 }
 
-inline void Design::setEndOffset(const std::size_t index, const Vector2 endOffset)
+template <class T>
+inline void DesignBase<T>::setEndOffset(const std::size_t index, const Vector2 endOffset)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].end = endOffset;
+	m_offsets[index].end = endOffset;
+	priv_invalidate(index);
 }
 
-inline void Design::setStartAnchorPoint(const std::size_t index, const AnchorPoint anchorPoint)
+template <class T>
+inline void DesignBase<T>::setStartAnchorPoint(const std::size_t index, const AnchorPoint anchorPoint)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].start = { anchorPoint, anchorPoint };
+	priv_setAnchorPoint(index, ValueType::Start, ComponentType::X, anchorPoint);
+	priv_setAnchorPoint(index, ValueType::Start, ComponentType::Y, anchorPoint);
+	priv_invalidate(index);
 }
 
-inline void Design::setStartOffsetXAnchorPoint(const std::size_t index, const AnchorPoint anchorPoint)
+template <class T>
+inline void DesignBase<T>::setStartOffsetXAnchorPoint(const std::size_t index, const AnchorPoint anchorPoint)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].start.x.anchor = anchorPoint;
+	priv_setAnchorPoint(index, ValueType::Start, ComponentType::X, anchorPoint);
+	priv_invalidate(index);
 }
 
-inline void Design::setStartOffsetYAnchorPoint(const std::size_t index, const AnchorPoint anchorPoint)
+template <class T>
+inline void DesignBase<T>::setStartOffsetYAnchorPoint(const std::size_t index, const AnchorPoint anchorPoint)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].start.y.anchor = anchorPoint;
+	priv_setAnchorPoint(index, ValueType::Start, ComponentType::Y, anchorPoint);
+	priv_invalidate(index);
 }
 
-inline void Design::setEndAnchorPoint(const std::size_t index, const AnchorPoint anchorPoint)
+template <class T>
+inline void DesignBase<T>::setEndAnchorPoint(const std::size_t index, const AnchorPoint anchorPoint)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].end = { anchorPoint, anchorPoint };
+	priv_setAnchorPoint(index, ValueType::End, ComponentType::X, anchorPoint);
+	priv_setAnchorPoint(index, ValueType::End, ComponentType::Y, anchorPoint);
+	priv_invalidate(index);
 }
 
-inline void Design::setEndOffsetXAnchorPoint(const std::size_t index, const AnchorPoint anchorPoint)
+template <class T>
+inline void DesignBase<T>::setEndOffsetXAnchorPoint(const std::size_t index, const AnchorPoint anchorPoint)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].end.x.anchor = anchorPoint;
+	priv_setAnchorPoint(index, ValueType::End, ComponentType::X, anchorPoint);
+	priv_invalidate(index);
 }
 
-inline void Design::setEndOffsetYAnchorPoint(const std::size_t index, const AnchorPoint anchorPoint)
+template <class T>
+inline void DesignBase<T>::setEndOffsetYAnchorPoint(const std::size_t index, const AnchorPoint anchorPoint)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].end.y.anchor = anchorPoint;
+	priv_setAnchorPoint(index, ValueType::End, ComponentType::Y, anchorPoint);
+	priv_invalidate(index);
 }
 
-inline void Design::setStartOffsetRelationType(const std::size_t index, const RelationType relationType)
+template <class T>
+inline void DesignBase<T>::setStartOffsetRelationType(const std::size_t index, const RelationType relationType)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].start = { relationType, relationType };
+	priv_setRelationType(index, ValueType::Start, ComponentType::X, relationType);
+	priv_setRelationType(index, ValueType::Start, ComponentType::Y, relationType);
+	priv_invalidate(index);
 }
 
-inline void Design::setStartOffsetXRelationType(const std::size_t index, const RelationType relationType)
+template <class T>
+inline void DesignBase<T>::setStartOffsetXRelationType(const std::size_t index, const RelationType relationType)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].start.x.relation = relationType;
+	priv_setRelationType(index, ValueType::Start, ComponentType::X, relationType);
+	priv_invalidate(index);
 }
 
-inline void Design::setStartOffsetYRelationType(const std::size_t index, const RelationType relationType)
+template <class T>
+inline void DesignBase<T>::setStartOffsetYRelationType(const std::size_t index, const RelationType relationType)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].start.y.relation = relationType;
+	priv_setRelationType(index, ValueType::Start, ComponentType::Y, relationType);
+	priv_invalidate(index);
 }
 
-inline void Design::setEndOffsetRelationType(const std::size_t index, const RelationType relationType)
+template <class T>
+inline void DesignBase<T>::setEndOffsetRelationType(const std::size_t index, const RelationType relationType)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].end = { relationType, relationType };
+	priv_setRelationType(index, ValueType::End, ComponentType::X, relationType);
+	priv_setRelationType(index, ValueType::End, ComponentType::Y, relationType);
+	priv_invalidate(index);
 }
 
-inline void Design::setEndOffsetXRelationType(const std::size_t index, const RelationType relationType)
+template <class T>
+inline void DesignBase<T>::setEndOffsetXRelationType(const std::size_t index, const RelationType relationType)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].end.x.relation = relationType;
+	priv_setRelationType(index, ValueType::End, ComponentType::X, relationType);
+	priv_invalidate(index);
 }
 
-inline void Design::setEndOffsetYRelationType(const std::size_t index, const RelationType relationType)
+template <class T>
+inline void DesignBase<T>::setEndOffsetYRelationType(const std::size_t index, const RelationType relationType)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].end.y.relation = relationType;
+	priv_setRelationType(index, ValueType::End, ComponentType::Y, relationType);
+	priv_invalidate(index);
 }
 
-inline void Design::setGeneric(const std::size_t index, std::size_t genericIndex, const float genericValue)
+template <class T>
+inline void DesignBase<T>::setGeneric(const std::size_t index, std::size_t genericIndex, const T genericValue)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].generics[genericIndex].value = genericValue;
+	m_genericValues[(index * m_numOfGenerics) + genericIndex] = genericValue;
+	priv_invalidate(index);
 }
 
-inline void Design::setGenericRelationType(const std::size_t index, const std::size_t genericIndex, const RelationType relationType)
+template <class T>
+inline void DesignBase<T>::setGenericRelationType(const std::size_t index, const std::size_t genericIndex, const RelationType relationType)
 {
 	if (!priv_isValidFrameIndex(index))
 		return;
 
-	m_frames[index].generics[genericIndex].relation = relationType;
+	priv_setRelationType(index, ValueType::Generic, ComponentType::X, relationType, genericIndex);
+	priv_invalidate(index);
 }
 
-inline int Design::getParent(const std::size_t index) const
+template <class T>
+inline int DesignBase<T>::getParent(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return -1;
@@ -337,7 +1118,8 @@ inline int Design::getParent(const std::size_t index) const
 	return m_frames[index].parentIndex;
 }
 
-inline int Design::getGroup(const std::size_t index) const
+template <class T>
+inline int DesignBase<T>::getGroup(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return 0;
@@ -345,7 +1127,8 @@ inline int Design::getGroup(const std::size_t index) const
 	return m_frames[index].groupId;
 }
 
-inline int Design::getDepth(const std::size_t index) const
+template <class T>
+inline int DesignBase<T>::getDepth(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return 0;
@@ -353,143 +1136,149 @@ inline int Design::getDepth(const std::size_t index) const
 	return m_frames[index].depth;
 }
 
-inline Vector2 Design::getStartOffset(const std::size_t index) const
+template <class T>
+inline Vector2Base<T> DesignBase<T>::getStartOffset(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
-	return m_frames[index].start.getValue2();
+	return m_offsets[index].start;
 }
 
-inline Vector2 Design::getEndOffset(const std::size_t index) const
+template <class T>
+inline Vector2Base<T> DesignBase<T>::getEndOffset(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
-	return m_frames[index].end.getValue2();
+	return m_offsets[index].end;
 }
 
-inline float Design::getGeneric(const std::size_t index, const std::size_t genericIndex) const
+template <class T>
+inline T DesignBase<T>::getGeneric(const std::size_t index, const std::size_t genericIndex) const
 {
 	if (!priv_isValidFrameIndex(index))
-		return 0.f;
+		return T{};
 
-	return m_frames[index].generics[genericIndex].value;
+	return m_genericValues[(index * m_numOfGenerics) + genericIndex];
 }
 
-inline AnchorPoint Design::getStartOffsetXAnchorPoint(const std::size_t index) const
+template <class T>
+inline AnchorPoint DesignBase<T>::getStartOffsetXAnchorPoint(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
-	return m_frames[index].start.x.anchor;
+	return priv_getProperty(index, ValueType::Start, ComponentType::X).anchor;
 }
 
-inline AnchorPoint Design::getStartOffsetYAnchorPoint(const std::size_t index) const
+template <class T>
+inline AnchorPoint DesignBase<T>::getStartOffsetYAnchorPoint(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
-	return m_frames[index].start.y.anchor;
+	return priv_getProperty(index, ValueType::Start, ComponentType::Y).anchor;
 }
 
-inline AnchorPoint Design::getEndOffsetXAnchorPoint(const std::size_t index) const
+template <class T>
+inline AnchorPoint DesignBase<T>::getEndOffsetXAnchorPoint(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
-	return m_frames[index].end.x.anchor;
+	return priv_getProperty(index, ValueType::End, ComponentType::X).anchor;
 }
 
-inline AnchorPoint Design::getEndOffsetYAnchorPoint(const std::size_t index) const
+template <class T>
+inline AnchorPoint DesignBase<T>::getEndOffsetYAnchorPoint(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
-	return m_frames[index].end.y.anchor;
+	return priv_getProperty(index, ValueType::End, ComponentType::Y).anchor;
 }
 
-inline RelationType Design::getStartOffsetXRelationType(const std::size_t index) const
+template <class T>
+inline RelationType DesignBase<T>::getStartOffsetXRelationType(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
-	return m_frames[index].start.x.relation;
+	return priv_getProperty(index, ValueType::Start, ComponentType::X).relation;
 }
 
-inline RelationType Design::getStartOffsetYRelationType(const std::size_t index) const
+template <class T>
+inline RelationType DesignBase<T>::getStartOffsetYRelationType(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
-	return m_frames[index].start.y.relation;
+	return priv_getProperty(index, ValueType::Start, ComponentType::Y).relation;
 }
 
-inline RelationType Design::getEndOffsetXRelationType(const std::size_t index) const
+template <class T>
+inline RelationType DesignBase<T>::getEndOffsetXRelationType(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
-	return m_frames[index].end.x.relation;
+	return priv_getProperty(index, ValueType::End, ComponentType::X).relation;
 }
 
-inline RelationType Design::getEndOffsetYRelationType(const std::size_t index) const
+template <class T>
+inline RelationType DesignBase<T>::getEndOffsetYRelationType(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
-	return m_frames[index].end.y.relation;
+	return priv_getProperty(index, ValueType::End, ComponentType::Y).relation;
 }
 
-inline RelationType Design::getGenericRelationType(const std::size_t index, const std::size_t genericIndex) const
+template <class T>
+inline RelationType DesignBase<T>::getGenericRelationType(const std::size_t index, const std::size_t genericIndex) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
-	return m_frames[index].generics[genericIndex].relation;
-}
-
-inline std::size_t Design::appendGeneric(const float genericValue, const RelationType relationType)
-{
-	resizeGenerics(m_numOfGenerics); // shouldn't be needed if everything else for generics is working properly. we'll leave it to make sure - for now, at least.
-
-	// could do the resize above with a "+1" and then set the value instead of pushing it back, maybe...
-
-	for (auto& frame : m_frames)
-		frame.generics.push_back({ genericValue, relationType });
-
-	return m_numOfGenerics++; // increase m_numOfGenerics but return the value before increasing (this is the index of the newly appended one)
+	return priv_getProperty(index, ValueType::Generic, ComponentType::X, genericIndex).relation;
 }
 
-inline void Design::resizeGenerics(const std::size_t numberOfGenerics)
+template <class T>
+inline std::size_t DesignBase<T>::appendGeneric(const T genericValue, const RelationType relationType)
 {
-	m_numOfGenerics = numberOfGenerics;
-	for (auto& frame : m_frames)
-		frame.generics.resize(m_numOfGenerics, { 0.f, RelationType::Relative }); // default generic of { 0, relative } added if not enough generics in frame
-}
+	const std::size_t genericIndex{ m_numOfGenerics };
+	resizeGenerics(m_numOfGenerics + 1u);
 
-inline void Design::removeGeneric(const std::size_t genericIndex)
-{
-	for (auto& frame : m_frames)
+	const std::uint8_t layout{ static_cast<std::uint8_t>(priv_packLayout(relationType, AnchorPoint::Start)) };
+	const std::size_t framesSize{ m_frames.size() };
+	priv_forEachVariantData([&](std::pmr::vector<Offsets>&, std::pmr::vector<T>& genericValues, std::pmr::vector<std::uint8_t>& genericLayouts)
 	{
-		if (frame.generics.empty())
-			continue;
-		if (frame.generics.size() > genericIndex)
-			frame.generics.erase(frame.generics.begin() + genericIndex);
-		if (frame.generics.size() > m_numOfGenerics)
-			m_numOfGenerics = frame.generics.size();
-	}
-	resizeGenerics(m_numOfGenerics);
+		for (std::size_t i{ 0u }; i < framesSize; ++i)
+		{
+			genericValues[(i * m_numOfGenerics) + genericIndex] = genericValue;
+			genericLayouts[(i * m_numOfGenerics) + genericIndex] = layout;
+		}
+	});
+
+	return genericIndex;
 }
 
-inline void Design::removeGenerics()
+template <class T>
+inline void DesignBase<T>::removeGenerics()
 {
 	m_numOfGenerics = 0u;
-	for (auto& frame : m_frames)
-		frame.generics.clear();
+	priv_forEachVariantData([](std::pmr::vector<Offsets>&, std::pmr::vector<T>& genericValues, std::pmr::vector<std::uint8_t>& genericLayouts)
+	{
+		genericValues.clear();
+		genericLayouts.clear();
+	});
+	++m_structureVersion;
+	priv_invalidateAll();
 }
 
-inline std::size_t Design::getNumberOfGenerics() const
+template <class T>
+inline std::size_t DesignBase<T>::getNumberOfGenerics() const
 {
 	return m_numOfGenerics;
 }
@@ -497,23 +1286,32 @@ inline std::size_t Design::getNumberOfGenerics() const
 
 
 
-inline Vector2 Design::getStartAbsolute(const std::size_t index) const
+template <class T>
+inline Vector2Base<T> DesignBase<T>::getStartAbsolute(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
+	if (m_isLayoutUpdated)
+		return m_layout.starts[index];
+
 	return priv_getLocal(index, ValueType::Start);
 }
 
-inline Vector2 Design::getEndAbsolute(const std::size_t index) const
+template <class T>
+inline Vector2Base<T> DesignBase<T>::getEndAbsolute(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
 
+	if (m_isLayoutUpdated)
+		return m_layout.ends[index];
+
 	return priv_getLocal(index, ValueType::End);
 }
 
-inline Vector2 Design::getSizeAbsolute(const std::size_t index) const
+template <class T>
+inline Vector2Base<T> DesignBase<T>::getSizeAbsolute(const std::size_t index) const
 {
 	if (!priv_isValidFrameIndex(index))
 		return{};
@@ -523,43 +1321,830 @@ inline Vector2 Design::getSizeAbsolute(const std::size_t index) const
 	return{ end.x - start.x, end.y - start.y };
 }
 
-inline float Design::getGenericAbsolute(const std::size_t index, const std::size_t genericIndex) const
+template <class T>
+inline T DesignBase<T>::getGenericAbsolute(const std::size_t index, const std::size_t genericIndex) const
 {
 	if (!priv_isValidFrameIndex(index))
-		return 0.f;
+		return T{};
+
+	if (m_isLayoutUpdated)
+		return m_layout.generics[(index * m_numOfGenerics) + genericIndex];
 
 	return priv_getLocalComponent(index, ValueType::Generic, ComponentType::X, genericIndex);
 }
 
-inline Vector2 Design::getPointInFrame(const std::size_t index, const Vector2 point, const RelationType relationType, const AnchorPoint anchorPoint) const
+template <class T>
+inline Vector2Base<T> DesignBase<T>::getPointInFrame(const std::size_t index, const Vector2 point, const RelationType relationType, const AnchorPoint anchorPoint) const
 {
 	return getPointInFrame(index, point, { relationType, relationType }, { anchorPoint, anchorPoint });
 }
 
-inline Vector2 Design::getPointInFrame(const std::size_t index, const Vector2 point, const Vector2Relation relations, const Vector2Anchor anchors) const
+template <class T>
+inline Vector2Base<T> DesignBase<T>::getPointInFrame(const std::size_t index, const Vector2 point, const Vector2Relation relations, const Vector2Anchor anchors) const
 {
 	return Vector2{
 		priv_unpackComponent({ point.x, relations.x, anchors.x }, ValueType::Start, static_cast<int>(index), ComponentType::X),
 		priv_unpackComponent({ point.y, relations.y, anchors.y }, ValueType::Start, static_cast<int>(index), ComponentType::Y) };
 }
 
+template <class T>
+inline std::vector<Vector2Base<T>> DesignBase<T>::getPointsInFrame(const std::size_t index, const std::vector<Vector2>& points, const RelationType relationType, const AnchorPoint anchorPoint) const
+{
+	return getPointsInFrame(index, points, { relationType, relationType }, { anchorPoint, anchorPoint });
+}
+
+template <class T>
+inline std::vector<Vector2Base<T>> DesignBase<T>::getPointsInFrame(const std::size_t index, const std::vector<Vector2>& points, const Vector2Relation relations, const Vector2Anchor anchors) const
+{
+	if (!priv_isValidFrameIndex(index))
+		return{};
+
+	std::vector<Vector2> results(points.size());
+	getPointsInFrame(index, points.data(), results.data(), points.size(), relations, anchors);
+	return results;
+}
 
+template <class T>
+inline Vector2Base<T> DesignBase<T>::getLocalPointInFrame(const std::size_t index, const Vector2 absolutePoint, const RelationType relationType, const AnchorPoint anchorPoint) const
+{
+	return getLocalPointInFrame(index, absolutePoint, { relationType, relationType }, { anchorPoint, anchorPoint });
+}
 
+template <class T>
+inline Vector2Base<T> DesignBase<T>::getLocalPointInFrame(const std::size_t index, const Vector2 absolutePoint, const Vector2Relation relations, const Vector2Anchor anchors) const
+{
+	if (!priv_isValidFrameIndex(index))
+		return{ T{}, T{} };
 
+	Vector2 result{ absolutePoint };
+	getLocalPointsInFrame(index, &absolutePoint, &result, 1u, relations, anchors);
+	return result;
+}
 
+template <class T>
+inline std::vector<Vector2Base<T>> DesignBase<T>::getLocalPointsInFrame(const std::size_t index, const std::vector<Vector2>& absolutePoints, const RelationType relationType, const AnchorPoint anchorPoint) const
+{
+	return getLocalPointsInFrame(index, absolutePoints, { relationType, relationType }, { anchorPoint, anchorPoint });
+}
 
+template <class T>
+inline std::vector<Vector2Base<T>> DesignBase<T>::getLocalPointsInFrame(const std::size_t index, const std::vector<Vector2>& absolutePoints, const Vector2Relation relations, const Vector2Anchor anchors) const
+{
+	if (!priv_isValidFrameIndex(index))
+		return{};
 
-// PRIVATE
+	std::vector<Vector2> results(absolutePoints.size());
+	getLocalPointsInFrame(index, absolutePoints.data(), results.data(), absolutePoints.size(), relations, anchors);
+	return results;
+}
 
-inline bool Design::priv_isValidFrameIndex(const int index) const
+template <class T>
+inline void DesignBase<T>::setClipsChildren(const std::size_t index, const bool clipsChildren)
 {
-	return (index >= 0) && (static_cast<std::size_t>(index) < m_frames.size());
+	if (!priv_isValidFrameIndex(index) || (priv_isClippingChildren(index) == clipsChildren))
+		return;
+
+	m_offsets[index].layout ^= layoutClipFlag;
+	priv_invalidate(index);
 }
 
-inline bool Design::priv_isValidFrameIndex(const std::size_t index) const
+template <class T>
+inline bool DesignBase<T>::getClipsChildren(const std::size_t index) const
 {
-	return index < m_frames.size();
+	if (!priv_isValidFrameIndex(index))
+		return false;
+
+	return priv_isClippingChildren(index);
+}
+
+template <class T>
+inline bool DesignBase<T>::isFullyClipped(const std::size_t index) const
+{
+	if (getClippingFrame(index) == -1)
+		return false;
+
+	const Rectangle clipRectangle{ getClipRectangle(index) };
+	return (clipRectangle.end.x < clipRectangle.start.x) || (clipRectangle.end.y < clipRectangle.start.y);
+}
+
+template <class T>
+template <class Allocator>
+inline void DesignBase<T>::getFullyClippedFrames(std::vector<std::size_t, Allocator>& frames) const
+{
+	frames.clear();
+
+	const std::size_t framesSize{ m_frames.size() };
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	{
+		if (isFullyClipped(i))
+			frames.push_back(i);
+	}
+}
+
+template <class T>
+template <class Allocator>
+inline void DesignBase<T>::getVisibleFrames(const IndexRange indices, std::vector<std::size_t, Allocator>& frames) const
+{
+	frames.clear();
+
+	for (const std::size_t index : indices)
+	{
+		if (priv_isValidFrameIndex(index) && !isFullyClipped(index))
+			frames.push_back(index);
+	}
+}
+
+template <class T>
+inline bool DesignBase<T>::isUpdated() const
+{
+	return m_isLayoutUpdated;
+}
+
+template <class T>
+inline const std::pmr::vector<std::size_t>& DesignBase<T>::getChangedFrames() const
+{
+	return m_changedFrames;
+}
+
+template <class T>
+inline bool DesignBase<T>::getHasChanged(const std::size_t index) const
+{
+	if (!priv_isValidFrameIndex(index))
+		return false;
+
+	return (m_frameStates[index] & frameStateChanged) != 0u;
 }
 
+template <class T>
+inline Vector2Base<T> DesignBase<T>::getPreviousStartAbsolute(const std::size_t index) const
+{
+	if (!priv_isValidFrameIndex(index) || (index >= m_layout.starts.size()))
+		return{};
+
+	return getHasChanged(index) ? m_previousLayout.starts[index] : m_layout.starts[index];
+}
+
+template <class T>
+inline Vector2Base<T> DesignBase<T>::getPreviousEndAbsolute(const std::size_t index) const
+{
+	if (!priv_isValidFrameIndex(index) || (index >= m_layout.ends.size()))
+		return{};
+
+	return getHasChanged(index) ? m_previousLayout.ends[index] : m_layout.ends[index];
+}
+
+template <class T>
+inline T DesignBase<T>::getPreviousGenericAbsolute(const std::size_t index, const std::size_t genericIndex) const
+{
+	const std::size_t genericValueIndex{ (index * m_numOfGenerics) + genericIndex };
+	if (!priv_isValidFrameIndex(index) || (genericValueIndex >= m_layout.generics.size()))
+		return T{};
+
+	return getHasChanged(index) ? m_previousLayout.generics[genericValueIndex] : m_layout.generics[genericValueIndex];
+}
+
+template <class T>
+inline std::size_t DesignBase<T>::getNumberOfVariants() const
+{
+	return m_variants.size();
+}
+
+template <class T>
+inline std::size_t DesignBase<T>::getActiveVariant() const
+{
+	return m_activeVariant;
+}
+
+template <class T>
+inline void DesignBase<T>::setVariantMinimumRootSize(const std::size_t variantIndex, const Vector2 minimumRootSize)
+{
+	if (variantIndex >= m_variants.size())
+		return;
+
+	m_variants[variantIndex].minimumRootSize = minimumRootSize;
+}
+
+template <class T>
+inline Vector2Base<T> DesignBase<T>::getVariantMinimumRootSize(const std::size_t variantIndex) const
+{
+	if (variantIndex >= m_variants.size())
+		return{};
+
+	return m_variants[variantIndex].minimumRootSize;
+}
+
+template <class T>
+inline std::pmr::memory_resource* DesignBase<T>::getMemoryResource() const
+{
+	return m_frames.get_allocator().resource();
+}
+
+template <class T>
+template <class Allocator>
+inline void DesignBase<T>::getFramesInGroup(const int groupId, std::vector<std::size_t, Allocator>& frames) const
+{
+	frames.clear();
+
+	const std::size_t framesSize{ m_frames.size() };
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	{
+		if (m_frames[i].groupId == groupId)
+			frames.push_back(i);
+	}
+}
+
+template <class T>
+template <class Allocator>
+inline void DesignBase<T>::getFramesInGroupRange(const int groupIdMin, const int groupIdMax, const bool useInsideRange, std::vector<std::size_t, Allocator>& frames) const
+{
+	frames.clear();
+
+	const std::size_t framesSize{ m_frames.size() };
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	{
+		if (useInsideRange == (m_frames[i].groupId >= groupIdMin) && (m_frames[i].groupId <= groupIdMax))
+			frames.push_back(i);
+	}
+}
+
+template <class T>
+template <class Allocator>
+inline void DesignBase<T>::getFramesInGroups(const std::vector<int>& groupIds, std::vector<std::size_t, Allocator>& frames) const
+{
+	frames.clear();
+
+	const std::size_t framesSize{ m_frames.size() };
+	for (std::size_t i{ 0u }; i < framesSize; ++i)
+	{
+		for (auto& groupId : groupIds)
+		{
+			if (m_frames[i].groupId == groupId)
+				frames.push_back(i);
+		}
+	}
+}
+
+template <class T>
+template <class Allocator>
+inline void DesignBase<T>::getFramesAtDepth(const int depth, std::vector<std::size_t, Allocator>& frames) const
+{
+	const IndexRange range{ getDrawOrderAtDepth(depth) };
+	frames.assign(range.begin(), range.end());
+}
+
+template <class T>
+template <class Allocator>
+inline void DesignBase<T>::getFramesInDepthRange(const int depthMin, const int depthMax, const bool useInsideRange, const bool sortAscending, std::vector<std::size_t, Allocator>& frames) const
+{
+	frames.clear();
+
+	// the draw order is already sorted
+	priv_forEachInDrawOrder(sortAscending, [&](const std::size_t i)
+	{
+		if (useInsideRange == (m_frames[i].groupId >= depthMin) && (m_frames[i].groupId <= depthMax))
+			frames.push_back(i);
+	});
+}
+
+template <class T>
+template <class Allocator>
+inline void DesignBase<T>::getFramesToDepth(const int depth, const bool useBelow, const bool sortAscending, std::vector<std::size_t, Allocator>& frames) const
+{
+	frames.clear();
+
+	// the draw order is already sorted
+	priv_forEachInDrawOrder(sortAscending, [&](const std::size_t i)
+	{
+		if ((m_frames[i].depth == depth) || (useBelow == (m_frames[i].depth < depth)))
+			frames.push_back(i);
+	});
+}
+
+template <class T>
+template <class Allocator>
+inline void DesignBase<T>::getFramesAtAllDepths(const bool sortAscending, std::vector<std::size_t, Allocator>& frames) const
+{
+	if (sortAscending)
+	{
+		frames.assign(m_drawOrder.begin(), m_drawOrder.end());
+		return;
+	}
+
+	frames.clear();
+	frames.reserve(m_drawOrder.size());
+	priv_forEachInDrawOrder(false, [&](const std::size_t i) { frames.push_back(i); });
+}
+
+template <class T>
+template <class Allocator>
+inline void DesignBase<T>::getDescendantsBreadthFirst(const std::size_t index, std::vector<std::size_t, Allocator>& descendants) const
+{
+	descendants.clear();
+	if (!priv_isValidFrameIndex(index))
+		return;
+
+	// the (growing) list of descendants is also the queue of frames whose children are still to be added
+	// a child is only added if it is inside the frame's depth-first subtree (a loop of parents would otherwise lead back to the frame)
+	descendants.reserve(getDescendants(index).size());
+	const std::size_t subtreeStart{ m_childrenIndex.depthFirstPositions[index] };
+	const std::size_t subtreeEnd{ subtreeStart + m_childrenIndex.subtreeSizes[index] };
+	std::size_t parent{ index };
+	std::size_t next{ 0u };
+	while (true)
+	{
+		for (std::size_t c{ m_childrenIndex.childrenStarts[parent] }; c < m_childrenIndex.childrenStarts[parent + 1u]; ++c)
+		{
+			const std::size_t child{ m_childrenIndex.children[c] };
+			const std::size_t position{ m_childrenIndex.depthFirstPositions[child] };
+			if ((position > subtreeStart) && (position < subtreeEnd))
+				descendants.push_back(child);
+		}
+		if (next == descendants.size())
+			break;
+		parent = descendants[next];
+		++next;
+	}
+}
+
+template <class T>
+inline typename DesignBase<T>::AncestorRange DesignBase<T>::getAncestors(const std::size_t index) const
+{
+	AncestorRange ancestors;
+	ancestors.m_design = this;
+	ancestors.m_parentIndex = (priv_isValidFrameIndex(index) && priv_isValidFrameIndex(m_frames[index].parentIndex)) ? m_frames[index].parentIndex : -1;
+	return ancestors;
+}
+
+template <class T>
+inline const std::pmr::vector<std::size_t>& DesignBase<T>::getDrawOrder() const
+{
+	return m_drawOrder;
+}
+
+template <class T>
+inline IndexRange DesignBase<T>::getDrawOrderAtDepth(const int depth) const
+{
+	return getDrawOrderInDepthRange(depth, depth);
+}
+
+template <class T>
+inline Vector2Base<T> DesignBase<T>::ResolvedLayout::getStartAbsolute(const std::size_t index) const
+{
+	if (index >= m_starts.size())
+		return{ T{}, T{} };
+
+	return m_starts[index];
+}
+
+template <class T>
+inline Vector2Base<T> DesignBase<T>::ResolvedLayout::getEndAbsolute(const std::size_t index) const
+{
+	if (index >= m_ends.size())
+		return{ T{}, T{} };
+
+	return m_ends[index];
+}
+
+template <class T>
+inline Vector2Base<T> DesignBase<T>::ResolvedLayout::getSizeAbsolute(const std::size_t index) const
+{
+	if (index >= m_starts.size())
+		return{ T{}, T{} };
+
+	return{ m_ends[index].x - m_starts[index].x, m_ends[index].y - m_starts[index].y };
+}
+
+template <class T>
+inline T DesignBase<T>::ResolvedLayout::getGenericAbsolute(const std::size_t index, const std::size_t genericIndex) const
+{
+	if ((index >= m_starts.size()) || (genericIndex >= m_numOfGenerics))
+		return T{};
+
+	return m_generics[(index * m_numOfGenerics) + genericIndex];
+}
+
+template <class T>
+inline void DesignBase<T>::LayoutProgram::setRootRectangle(const std::size_t index, const Rectangle rectangle)
+{
+	if (index >= m_instructionIndices.size())
+		return;
+
+	Instruction& instruction{ m_instructions[m_instructionIndices[index]] };
+	if (instruction.parentIndex != m_instructionIndices.size())
+		return;
+
+	// root components do not depend on their (zero) parent range so they are constants
+	const T zero{};
+	instruction.startX = { zero, zero, rectangle.start.x };
+	instruction.startY = { zero, zero, rectangle.start.y };
+	instruction.endX = { zero, zero, instruction.isPoint ? rectangle.start.x : rectangle.end.x };
+	instruction.endY = { zero, zero, instruction.isPoint ? rectangle.start.y : rectangle.end.y };
+	instruction.rangeStartX = instruction.startX;
+	instruction.rangeStartY = instruction.startY;
+	instruction.rangeEndX = { zero, zero, rectangle.end.x };
+	instruction.rangeEndY = { zero, zero, rectangle.end.y };
+}
+
+template <class T>
+inline void DesignBase<T>::LayoutProgram::run()
+{
+	const std::size_t instructionsSize{ m_instructions.size() };
+	for (std::size_t i{ 0u }; i < instructionsSize; ++i)
+	{
+		const Instruction& instruction{ m_instructions[i] };
+		const Vector2 parentStart{ m_rangeStarts[instruction.parentIndex] };
+		const Vector2 parentEnd{ m_rangeEnds[instruction.parentIndex] };
+		m_starts[instruction.index] = { priv_apply(instruction.startX, parentStart.x, parentEnd.x), priv_apply(instruction.startY, parentStart.y, parentEnd.y) };
+		m_ends[instruction.index] = { priv_apply(instruction.endX, parentStart.x, parentEnd.x), priv_apply(instruction.endY, parentStart.y, parentEnd.y) };
+		m_rangeStarts[instruction.index] = { priv_apply(instruction.rangeStartX, parentStart.x, parentEnd.x), priv_apply(instruction.rangeStartY, parentStart.y, parentEnd.y) };
+		m_rangeEnds[instruction.index] = { priv_apply(instruction.rangeEndX, parentStart.x, parentEnd.x), priv_apply(instruction.rangeEndY, parentStart.y, parentEnd.y) };
+
+		const Transform* const transforms{ m_genericTransforms.data() + (i * m_numOfGenerics) };
+		const T* const parentGenerics{ m_generics.data() + (instruction.parentIndex * m_numOfGenerics) };
+		T* const generics{ m_generics.data() + (instruction.index * m_numOfGenerics) };
+		for (std::size_t g{ 0u }; g < m_numOfGenerics; ++g)
+			generics[g] = (parentGenerics[g] * transforms[g].scale) + transforms[g].offset;
+	}
+}
+
+template <class T>
+inline Vector2Base<T> DesignBase<T>::LayoutProgram::getStartAbsolute(const std::size_t index) const
+{
+	if (index >= m_starts.size())
+		return{ T{}, T{} };
+
+	return m_starts[index];
+}
+
+template <class T>
+inline Vector2Base<T> DesignBase<T>::LayoutProgram::getEndAbsolute(const std::size_t index) const
+{
+	if (index >= m_ends.size())
+		return{ T{}, T{} };
+
+	return m_ends[index];
+}
+
+template <class T>
+inline Vector2Base<T> DesignBase<T>::LayoutProgram::getSizeAbsolute(const std::size_t index) const
+{
+	if (index >= m_starts.size())
+		return{ T{}, T{} };
+
+	return{ m_ends[index].x - m_starts[index].x, m_ends[index].y - m_starts[index].y };
+}
+
+template <class T>
+inline T DesignBase<T>::LayoutProgram::getGenericAbsolute(const std::size_t index, const std::size_t genericIndex) const
+{
+	if ((index >= m_starts.size()) || (genericIndex >= m_numOfGenerics))
+		return T{};
+
+	return m_generics[(index * m_numOfGenerics) + genericIndex];
+}
+
+template <class T>
+template <class Executor>
+inline std::future<std::shared_ptr<const typename DesignBase<T>::ResolvedLayout>> DesignBase<T>::resolveAsync(Executor executor)
+{
+	const std::size_t requestNumber{ ++(*m_resolveRequests.latest) }; // supersedes any previous requests
+	auto latestRequest{ m_resolveRequests.latest };
+	auto snapshot{ std::make_shared<DesignBase>(priv_getSnapshot()) };
+	auto promise{ std::make_shared<std::promise<std::shared_ptr<const ResolvedLayout>>>() };
+	std::future<std::shared_ptr<const ResolvedLayout>> future{ promise->get_future() };
+	executor([snapshot, promise, latestRequest, requestNumber]()
+	{
+		try
+		{
+			promise->set_value(priv_resolveSnapshot(*snapshot, requestNumber, *latestRequest));
+		}
+		catch (...)
+		{
+			promise->set_exception(std::current_exception()); // rethrown by the future's get (e.g. std::bad_alloc)
+		}
+	});
+	return future;
+}
+
+template <class T>
+inline void DesignBase<T>::cancelResolveAsync()
+{
+	++(*m_resolveRequests.latest);
+}
+
+template <class T>
+inline std::size_t DesignBase<T>::addAnimationTrack(const std::size_t index, const AnimationTarget target, const std::size_t genericIndex)
+{
+	m_animationTracks.push_back({ index, target, genericIndex, std::pmr::vector<Keyframe>(m_frames.get_allocator().resource()), 0u });
+	return m_animationTracks.size() - 1u;
+}
+
+template <class T>
+inline std::size_t DesignBase<T>::getNumberOfAnimationTracks() const
+{
+	return m_animationTracks.size();
+}
+
+template <class T>
+inline void DesignBase<T>::removeAnimationTracks()
+{
+	m_animationTracks.clear();
+}
+
+template <class T>
+inline void DesignBase<T>::setChangeCallback(const std::function<void(std::size_t index)> changeCallback)
+{
+	m_changeCallback = changeCallback;
+}
+
+template <class T>
+inline void DesignBase<T>::Transaction::setParent(const std::size_t index, int parentIndex)
+{
+	if (!m_design.priv_isValidFrameIndex(index))
+		return;
+
+	if (parentIndex < -1)
+		parentIndex = -1;
+	m_design.m_frames[index].parentIndex = parentIndex;
+	m_isStructureChanged = true;
+	priv_invalidate(index);
+}
+
+template <class T>
+inline void DesignBase<T>::Transaction::setGroup(const std::size_t index, const int groupId)
+{
+	if (!m_design.priv_isValidFrameIndex(index))
+		return;
+
+	m_design.m_frames[index].groupId = groupId;
+	m_design.priv_invalidateSnapshotChunk(index);
+}
+
+template <class T>
+inline void DesignBase<T>::Transaction::setDepth(const std::size_t index, const int depth)
+{
+	if (!m_design.priv_isValidFrameIndex(index) || (m_design.m_frames[index].depth == depth))
+		return;
+
+	m_design.m_frames[index].depth = depth;
+	m_design.priv_invalidateSnapshotChunk(index);
+
+	// the draw order itself is left unchanged (so that a range of it can be used while the transaction is open)
+	if (m_isDrawOrderChanged)
+		return;
+	for (std::size_t i{ 0u }; i < m_numberOfDepthChanges; ++i)
+	{
+		if (m_depthChangedFrames[i] == index)
+			return;
+	}
+	if (m_numberOfDepthChanges == maxDrawOrderMoves)
+		m_isDrawOrderChanged = true;
+	else
+		m_depthChangedFrames[m_numberOfDepthChanges++] = index;
+}
+
+template <class T>
+inline void DesignBase<T>::Transaction::setStartOffset(const std::size_t index, const Vector2 offset)
+{
+	if (!m_design.priv_isValidFrameIndex(index))
+		return;
+
+	m_design.m_offsets[index].start = offset;
+	priv_invalidate(index);
+}
+
+template <class T>
+inline void DesignBase<T>::Transaction::setEndOffset(const std::size_t index, const Vector2 offset)
+{
+	if (!m_design.priv_isValidFrameIndex(index))
+		return;
+
+	m_design.m_offsets[index].end = offset;
+	priv_invalidate(index);
+}
+
+template <class T>
+inline void DesignBase<T>::Transaction::moveFrame(const std::size_t index, const Vector2 amount)
+{
+	if (!m_design.priv_isValidFrameIndex(index))
+		return;
+
+	Offsets& offsets{ m_design.m_offsets[index] };
+	offsets.start = { offsets.start.x + amount.x, offsets.start.y + amount.y };
+	offsets.end = { offsets.end.x + amount.x, offsets.end.y + amount.y };
+	priv_invalidate(index);
+}
+
+template <class T>
+inline void DesignBase<T>::Transaction::setGeneric(const std::size_t index, const std::size_t genericIndex, const T genericValue)
+{
+	if (!m_design.priv_isValidFrameIndex(index) || (genericIndex >= m_design.m_numOfGenerics))
+		return;
+
+	m_design.m_genericValues[(index * m_design.m_numOfGenerics) + genericIndex] = genericValue;
+	priv_invalidate(index);
+}
+
+template <class T>
+inline void DesignBase<T>::Transaction::commit()
+{
+	// the draw order is sorted once for all depth changes (after too many to move individually)
+	if (m_isDrawOrderChanged)
+		m_design.priv_rebuildDrawOrder();
+	else if (m_numberOfDepthChanges > 0u)
+		m_design.priv_moveInDrawOrder(m_depthChangedFrames, m_depthChangedFrames + m_numberOfDepthChanges);
+	if (m_isStructureChanged)
+	{
+		m_design.m_isResolveOrderDirty = true;
+		m_design.m_isChildrenIndexDirty = true;
+		++m_design.m_structureVersion;
+	}
+	if (m_isChanged)
+		m_design.m_isLayoutUpdated = false;
+
+	m_numberOfDepthChanges = 0u;
+	m_isChanged = false;
+	m_isDrawOrderChanged = false;
+	m_isStructureChanged = false;
+}
+
+template <class T>
+inline void DesignBase<T>::Transaction::priv_invalidate(const std::size_t index)
+{
+	m_design.m_frameStates[index] |= frameStateDirty;
+	m_design.priv_invalidateSnapshotChunk(index);
+	m_isChanged = true;
+}
+
+
+
+
+
+
+
+// PRIVATE
+
+template <class T>
+inline bool DesignBase<T>::priv_isValidFrameIndex(const int index) const
+{
+	return (index >= 0) && (static_cast<std::size_t>(index) < m_frames.size());
+}
+
+template <class T>
+inline bool DesignBase<T>::priv_isValidFrameIndex(const std::size_t index) const
+{
+	return index < m_frames.size();
+}
+
+template <class T>
+inline void DesignBase<T>::priv_invalidate(const std::size_t index)
+{
+	m_frameStates[index] |= frameStateDirty;
+	m_isLayoutUpdated = false;
+	priv_invalidateSnapshotChunk(index);
+}
+
+template <class T>
+inline void DesignBase<T>::priv_addFrame()
+{
+	add(Property2{}, false, -1, 0, 0, Property2{});
+}
+
+template <class T>
+inline void DesignBase<T>::priv_invalidateAll()
+{
+	for (auto& frameState : m_frameStates)
+		frameState |= frameStateDirty;
+	m_isLayoutUpdated = false;
+	m_snapshotChunks.clear();
+}
+
+template <class T>
+inline void DesignBase<T>::priv_invalidateSnapshotChunk(const std::size_t index)
+{
+	// the chunk is copied by the next snapshot
+	const std::size_t chunkIndex{ index / framesPerSnapshotChunk };
+	if (chunkIndex < m_snapshotChunks.size())
+		m_snapshotChunks[chunkIndex].reset();
+}
+
+template <class T>
+inline bool DesignBase<T>::priv_isDifferent(const T a, const T b, const T epsilon)
+{
+	return (a > b) ? ((a - b) > epsilon) : ((b - a) > epsilon);
+}
+
+template <class T>
+template <class Function>
+inline void DesignBase<T>::priv_forEachVariantData(Function function)
+{
+	function(m_offsets, m_genericValues, m_genericLayouts);
+
+	const std::size_t variantsSize{ m_variants.size() };
+	for (std::size_t v{ 0u }; v < variantsSize; ++v)
+	{
+		if (v != m_activeVariant)
+			function(m_variants[v].offsets, m_variants[v].genericValues, m_variants[v].genericLayouts);
+	}
+}
+
+template <class T>
+template <class Function>
+inline void DesignBase<T>::priv_forEachInDrawOrder(const bool ascending, Function function) const
+{
+	if (ascending)
+	{
+		for (auto& index : m_drawOrder)
+			function(index);
+		return;
+	}
+
+	// visit each run of equal depth from the back, but visit the frames within that run from its front
+	std::size_t runEnd{ m_drawOrder.size() };
+	while (runEnd > 0u)
+	{
+		const int depth{ m_frames[m_drawOrder[runEnd - 1u]].depth };
+		std::size_t runStart{ runEnd - 1u };
+		while ((runStart > 0u) && (m_frames[m_drawOrder[runStart - 1u]].depth == depth))
+			--runStart;
+		for (std::size_t i{ runStart }; i < runEnd; ++i)
+			function(m_drawOrder[i]);
+		runEnd = runStart;
+	}
+}
+
+template <class T>
+inline unsigned int DesignBase<T>::priv_getLayoutShift(const ValueType valueType, const ComponentType componentType)
+{
+	// start x, start y, end x, end y
+	return ((valueType == ValueType::End) ? 8u : 0u) + ((componentType == ComponentType::Y) ? 4u : 0u);
+}
+
+template <class T>
+inline std::uint32_t DesignBase<T>::priv_packLayout(const RelationType relationType, const AnchorPoint anchorPoint)
+{
+	return static_cast<std::uint32_t>(relationType) | (static_cast<std::uint32_t>(anchorPoint) << 2u);
+}
+
+template <class T>
+inline PropertyBase<T> DesignBase<T>::priv_unpackLayout(const T value, const std::uint32_t layout)
+{
+	return{ value, static_cast<RelationType>(layout & layoutRelationMask), static_cast<AnchorPoint>((layout & layoutAnchorMask) >> 2u) };
+}
+
+template <class T>
+inline PropertyBase<T> DesignBase<T>::priv_getProperty(const std::size_t index, const ValueType valueType, const ComponentType componentType, const std::size_t genericIndex) const
+{
+	if (valueType == ValueType::Generic)
+		return priv_unpackLayout(m_genericValues[(index * m_numOfGenerics) + genericIndex], m_genericLayouts[(index * m_numOfGenerics) + genericIndex]);
+
+	const Offsets& offsets{ m_offsets[index] };
+	const Vector2& value{ (valueType == ValueType::End) ? offsets.end : offsets.start };
+	return priv_unpackLayout((componentType == ComponentType::Y) ? value.y : value.x, offsets.layout >> priv_getLayoutShift(valueType, componentType));
+}
+
+template <class T>
+inline void DesignBase<T>::priv_setRelationType(const std::size_t index, const ValueType valueType, const ComponentType componentType, const RelationType relationType, const std::size_t genericIndex)
+{
+	if (valueType == ValueType::Generic)
+	{
+		std::uint8_t& layout{ m_genericLayouts[(index * m_numOfGenerics) + genericIndex] };
+		layout = static_cast<std::uint8_t>((layout & ~layoutRelationMask) | priv_packLayout(relationType, AnchorPoint::Start));
+		return;
+	}
+
+	const unsigned int shift{ priv_getLayoutShift(valueType, componentType) };
+	std::uint32_t& layout{ m_offsets[index].layout };
+	layout = (layout & ~(layoutRelationMask << shift)) | (priv_packLayout(relationType, AnchorPoint::Start) << shift);
+}
+
+template <class T>
+inline void DesignBase<T>::priv_setAnchorPoint(const std::size_t index, const ValueType valueType, const ComponentType componentType, const AnchorPoint anchorPoint)
+{
+	const unsigned int shift{ priv_getLayoutShift(valueType, componentType) };
+	std::uint32_t& layout{ m_offsets[index].layout };
+	layout = (layout & ~(layoutAnchorMask << shift)) | (priv_packLayout(RelationType::Absolute, anchorPoint) << shift);
+}
+
+template <class T>
+inline bool DesignBase<T>::priv_isPoint(const std::size_t index) const
+{
+	return (m_offsets[index].layout & layoutPointFlag) != 0u;
+}
+
+template <class T>
+inline bool DesignBase<T>::priv_isClippingChildren(const std::size_t index) const
+{
+	return (m_offsets[index].layout & layoutClipFlag) != 0u;
+}
+
+using Design = DesignBase<float>;
+
+// instantiated in Scaylay.cpp
+extern template class DesignBase<float>;
+extern template class DesignBase<double>;
+extern template class DesignBase<Fixed32>;
+extern template class DesignBase<Fixed16>;
+
 } // namespace scaylay
 #endif // SCAYLAY_SCAYLAY_HPP
@@ -30,9 +30,72 @@
 #ifndef SCAYLAY_SCAYLAYTYPES_HPP
 #define SCAYLAY_SCAYLAYTYPES_HPP
 
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
 namespace scaylay
 {
 
+// fixed-point scalar that can be used in place of float (e.g. DesignBase<Fixed32>)
+// conversions to and from floating-point are explicit. results outside the range (of conversions and of arithmetic, which is done in 64 bits) saturate to the nearest limit
+template <class StorageT, unsigned int FractionBits>
+class FixedPoint
+{
+public:
+	using Storage = StorageT;
+
+	constexpr FixedPoint() : m_raw{ 0 } {}
+	explicit constexpr FixedPoint(const double value) : m_raw{ priv_saturate((value * one) + ((value < 0.0) ? -0.5 : 0.5)) } {}
+	template <class OtherStorageT, unsigned int OtherFractionBits>
+	explicit constexpr FixedPoint(const FixedPoint<OtherStorageT, OtherFractionBits> other) : FixedPoint(static_cast<double>(other)) {}
+
+	static constexpr FixedPoint fromRaw(const Storage raw) { FixedPoint result; result.m_raw = raw; return result; }
+	constexpr Storage getRaw() const { return m_raw; }
+
+	explicit constexpr operator double() const { return static_cast<double>(m_raw) / one; }
+	explicit constexpr operator float() const { return static_cast<float>(static_cast<double>(m_raw) / one); }
+
+	constexpr FixedPoint operator-() const { return fromRaw(priv_saturate(-static_cast<std::int64_t>(m_raw))); }
+	constexpr FixedPoint operator+(const FixedPoint other) const { return fromRaw(priv_saturate(static_cast<std::int64_t>(m_raw) + other.m_raw)); }
+	constexpr FixedPoint operator-(const FixedPoint other) const { return fromRaw(priv_saturate(static_cast<std::int64_t>(m_raw) - other.m_raw)); }
+	constexpr FixedPoint operator*(const FixedPoint other) const { return fromRaw(priv_saturate((static_cast<std::int64_t>(m_raw) * other.m_raw) / one)); }
+	constexpr FixedPoint operator/(const FixedPoint other) const { return (other.m_raw == 0) ? FixedPoint{} : fromRaw(priv_saturate((static_cast<std::int64_t>(m_raw) * one) / other.m_raw)); } // division by zero results in zero
+	FixedPoint& operator+=(const FixedPoint other) { return *this = *this + other; }
+	FixedPoint& operator-=(const FixedPoint other) { return *this = *this - other; }
+	FixedPoint& operator*=(const FixedPoint other) { return *this = *this * other; }
+	FixedPoint& operator/=(const FixedPoint other) { return *this = *this / other; }
+
+	constexpr bool operator==(const FixedPoint other) const { return m_raw == other.m_raw; }
+	constexpr bool operator!=(const FixedPoint other) const { return m_raw != other.m_raw; }
+	constexpr bool operator<(const FixedPoint other) const { return m_raw < other.m_raw; }
+	constexpr bool operator>(const FixedPoint other) const { return m_raw > other.m_raw; }
+	constexpr bool operator<=(const FixedPoint other) const { return m_raw <= other.m_raw; }
+	constexpr bool operator>=(const FixedPoint other) const { return m_raw >= other.m_raw; }
+
+private:
+	static constexpr std::int64_t one{ std::int64_t{ 1 } << FractionBits };
+
+	Storage m_raw;
+
+	static constexpr Storage priv_saturate(const double raw) // NaN becomes zero
+	{
+		return (raw != raw) ? Storage{ 0 } :
+			(raw >= static_cast<double>(std::numeric_limits<Storage>::max())) ? std::numeric_limits<Storage>::max() :
+			(raw <= static_cast<double>(std::numeric_limits<Storage>::min())) ? std::numeric_limits<Storage>::min() :
+			static_cast<Storage>(raw);
+	}
+	static constexpr Storage priv_saturate(const std::int64_t raw)
+	{
+		return (raw > std::numeric_limits<Storage>::max()) ? std::numeric_limits<Storage>::max() :
+			(raw < std::numeric_limits<Storage>::min()) ? std::numeric_limits<Storage>::min() :
+			static_cast<Storage>(raw);
+	}
+};
+using Fixed32 = FixedPoint<std::int32_t, 16u>; // 16.16: range of +/-32768 with a precision of 1/65536
+using Fixed16 = FixedPoint<std::int16_t, 4u>; // 12.4: range of +/-2048 with a precision of 1/16 (small designs only: e.g. pixel co-ordinates beyond 2047 saturate)
+
 template <class T = float>
 struct Vector2Base
 {
@@ -52,7 +115,14 @@ enum class AnchorPoint
 	End,
 	Size,
 };
+template <class T = float>
+struct RectangleBase
+{
+	Vector2Base<T> start;
+	Vector2Base<T> end;
+};
 using Vector2 = Vector2Base<float>;
+using Rectangle = RectangleBase<float>;
 using Vector2Relation = Vector2Base<RelationType>;
 using Vector2Anchor = Vector2Base<AnchorPoint>;
 template <class T = float>
@@ -85,13 +155,80 @@ struct Property2Base
 	}
 
 	Vector2Base<T> getValue2() const { return{ x.value, y.value }; }
-	void operator=(const Vector2 vector2) { x.value = vector2.x; y.value = vector2.y; }
+	void operator=(const Vector2Base<T> vector2) { x.value = vector2.x; y.value = vector2.y; }
 	void operator=(const Vector2Relation relation2) { x.relation = relation2.x; y.relation = relation2.y; }
 	void operator=(const Vector2Anchor anchor2) { x.anchor = anchor2.x; y.anchor = anchor2.y; }
 };
 using Property = PropertyBase<float>;
 using Property2 = Property2Base<float>;
 
+// read-only view of a contiguous sequence of frame indices (e.g. part of a draw order or a vector of indices). views into a design are only valid until the design is next changed
+struct IndexRange
+{
+	const std::size_t* first;
+	const std::size_t* last;
+
+	IndexRange() : first{ nullptr }, last{ nullptr } {}
+	IndexRange(const std::size_t* const rangeFirst, const std::size_t* const rangeLast) : first{ rangeFirst }, last{ rangeLast } {}
+	template <class Allocator>
+	IndexRange(const std::vector<std::size_t, Allocator>& indices) : first{ indices.data() }, last{ indices.data() + indices.size() } {}
+
+	const std::size_t* begin() const { return first; }
+	const std::size_t* end() const { return last; }
+	std::size_t size() const { return static_cast<std::size_t>(last - first); }
+	bool empty() const { return first == last; }
+	std::size_t operator[](const std::size_t i) const { return first[i]; }
+};
+enum class AnimationTarget
+{
+	StartX,
+	StartY,
+	EndX,
+	EndY,
+	Generic,
+};
+enum class Easing // how an animated value approaches a keyframe
+{
+	Linear,
+	In, // accelerates (quadratic)
+	Out, // decelerates (quadratic)
+	InOut, // accelerates then decelerates (smoothstep)
+	Step, // keeps the previous value until the keyframe is reached
+};
+enum class ExportType
+{
+	Quad, // 4 vertices per frame (start, top-right, end, bottom-left), each with a position
+	Rectangle, // 1 instance per frame with a position (start) and a size
+	PixelRectangle, // as Rectangle but position, size and depth are rounded to std::int16_t
+};
+// describes where values are written within each vertex/instance of a caller's buffer. all offsets and the stride are in bytes
+// position, size and depth are written as the design's scalar type (or std::int16_t for PixelRectangle); generics are always written as the design's scalar type
+struct ExportLayout
+{
+	struct Generic
+	{
+		std::size_t genericIndex;
+		std::size_t offset;
+	};
+
+	static constexpr std::size_t unused{ ~std::size_t{ 0u } };
+
+	ExportType type{ ExportType::Quad };
+	std::size_t stride{ 0u };
+	std::size_t positionOffset{ 0u };
+	std::size_t sizeOffset{ unused }; // ignored by Quad
+	std::size_t depthOffset{ unused };
+	std::vector<Generic> generics; // written to every vertex of a quad
+};
+
+// explicit conversions between scalar types
+template <class T, class U>
+Vector2Base<T> vector2Cast(const Vector2Base<U> vector2) { return{ static_cast<T>(vector2.x), static_cast<T>(vector2.y) }; }
+template <class T, class U>
+PropertyBase<T> propertyCast(const PropertyBase<U> property) { return{ static_cast<T>(property.value), property.relation, property.anchor }; }
+template <class T, class U>
+Property2Base<T> property2Cast(const Property2Base<U> property2) { return{ propertyCast<T>(property2.x), propertyCast<T>(property2.y) }; }
+
 } // namespace scaylay
 
 #ifndef SCAYLAY_NO_NAMESPACE_SHORTCUT